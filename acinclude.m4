@@ -1,6 +1,22 @@
 dnl Checks for required headers and functions
 dnl
-dnl Version: 20240513
+dnl Version: 20261017
+
+dnl Function to detect if the compiler supports the __atomic built-in functions
+AC_DEFUN([AX_LIBCERROR_CHECK_CC_ATOMIC],
+  [AC_CACHE_CHECK(
+    [whether $CC supports __atomic built-in functions],
+    [ac_cv_cc___atomic],
+    [AC_LANG_PUSH(C)
+    AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM(
+        [[#include <stdint.h>
+static uint64_t value = 0;]],
+        [[__atomic_fetch_add( &value, 1, __ATOMIC_RELAXED ); __atomic_store_n( &value, 0, __ATOMIC_RELAXED ); return( (int) __atomic_load_n( &value, __ATOMIC_RELAXED ) );]] )],
+      [ac_cv_cc___atomic=yes],
+      [ac_cv_cc___atomic=no])
+    AC_LANG_POP(C)])
+  ])
 
 dnl Function to detect if libcerror dependencies are available
 AC_DEFUN([AX_LIBCERROR_CHECK_LOCAL],
@@ -14,6 +30,196 @@ AC_DEFUN([AX_LIBCERROR_CHECK_LOCAL],
       [1])
     ])
 
+  dnl Memory functions used in libcerror/libcerror_error.c
+  AC_CHECK_FUNCS([memmove])
+
+  dnl Headers and functions used in libcerror/libcerror_error.c
+  AC_CHECK_HEADERS([sys/uio.h])
+  AC_CHECK_FUNCS([writev])
+
+  dnl Stream locking functions used in libcerror/libcerror_error.c
+  AC_CHECK_FUNCS([flockfile funlockfile fwrite_unlocked])
+
+  AS_IF(
+    [test "x$ac_cv_func_memmove" != xyes],
+    [AC_MSG_FAILURE(
+      [Missing function: memmove],
+      [1])
+    ])
+
+  dnl Check for thread-local storage used in libcerror/libcerror_format.c
+  AC_CACHE_CHECK(
+    [whether $CC supports __thread],
+    [ac_cv_cc___thread],
+    [AC_LANG_PUSH(C)
+    AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM(
+        [[static __thread int value = 0;]],
+        [[value = 1; return( value - 1 );]] )],
+      [ac_cv_cc___thread=yes],
+      [ac_cv_cc___thread=no])
+    AC_LANG_POP(C)])
+
+  AS_IF(
+    [test "x$ac_cv_cc___thread" = xyes],
+    [AC_DEFINE(
+      [HAVE___THREAD],
+      [1],
+      [Define to 1 if the compiler supports the __thread storage class specifier.])
+    ])
+
+  dnl Check if the error pool should be disabled
+  AX_COMMON_ARG_DISABLE(
+    [error-pool],
+    [error_pool],
+    [thread-local pool of freed errors])
+
+  dnl Headers and functions used in libcerror/libcerror_pool.c
+  AS_IF(
+    [test "x$ac_cv_enable_error_pool" != xno && test "x$ac_cv_cc___thread" = xyes],
+    [AC_CHECK_HEADERS([pthread.h])
+
+    AC_SEARCH_LIBS(
+      [pthread_key_create],
+      [pthread])
+
+    AS_IF(
+      [test "x$ac_cv_header_pthread_h" = xyes && test "x$ac_cv_search_pthread_key_create" != xno],
+      [AC_DEFINE(
+        [HAVE_ERROR_POOL],
+        [1],
+        [Define to 1 to enable the thread-local pool of freed errors.])
+
+      AS_IF(
+        [test "x$ac_cv_search_pthread_key_create" != "xnone required"],
+        [AC_SUBST(
+          [ax_libcerror_pc_libs_private],
+          [$ac_cv_search_pthread_key_create])
+        ])
+      ],
+      [ac_cv_enable_error_pool=no])
+    ],
+    [ac_cv_enable_error_pool=no])
+
+  dnl Check if the error statistics should be enabled
+  AX_COMMON_ARG_ENABLE(
+    [error-statistics],
+    [error_statistics],
+    [per error domain and code statistics],
+    [no])
+
+  dnl Check if the error lifetime statistics should be enabled
+  AX_COMMON_ARG_ENABLE(
+    [error-lifetime-statistics],
+    [error_lifetime_statistics],
+    [error lifetime and depth histograms],
+    [no])
+
+  dnl Check for atomic operations used in libcerror/libcerror_statistics.c
+  dnl and libcerror/libcerror_lifetime.c
+  AS_IF(
+    [test "x$ac_cv_enable_error_statistics" != xno || test "x$ac_cv_enable_error_lifetime_statistics" != xno],
+    [AX_LIBCERROR_CHECK_CC_ATOMIC])
+
+  AS_IF(
+    [test "x$ac_cv_enable_error_statistics" != xno],
+    [AS_IF(
+      [test "x$ac_cv_cc___atomic" = xyes],
+      [AC_DEFINE(
+        [HAVE_ERROR_STATISTICS],
+        [1],
+        [Define to 1 to enable the per error domain and code statistics.])
+      ],
+      [ac_cv_enable_error_statistics=no])
+    ])
+
+  dnl Functions used in libcerror/libcerror_lifetime.c
+  AS_IF(
+    [test "x$ac_cv_enable_error_lifetime_statistics" != xno],
+    [AC_SEARCH_LIBS(
+      [clock_gettime],
+      [rt])
+
+    AS_IF(
+      [test "x$ac_cv_cc___atomic" = xyes && test "x$ac_cv_search_clock_gettime" != xno],
+      [AC_DEFINE(
+        [HAVE_ERROR_LIFETIME_STATISTICS],
+        [1],
+        [Define to 1 to enable the error lifetime and depth histograms.])
+
+      AS_IF(
+        [test "x$ac_cv_search_clock_gettime" != "xnone required"],
+        [AC_SUBST(
+          [ax_libcerror_pc_libs_private],
+          ["$ax_libcerror_pc_libs_private $ac_cv_search_clock_gettime"])
+        ])
+      ],
+      [ac_cv_enable_error_lifetime_statistics=no])
+    ])
+
+  dnl Check if the live error registry should be enabled
+  AX_COMMON_ARG_ENABLE(
+    [error-registry],
+    [error_registry],
+    [registry of live errors to report errors that are not freed],
+    [no])
+
+  dnl Headers and functions used in libcerror/libcerror_registry.c
+  AS_IF(
+    [test "x$ac_cv_enable_error_registry" != xno],
+    [AC_CHECK_HEADERS([pthread.h])
+
+    AC_SEARCH_LIBS(
+      [pthread_mutex_lock],
+      [pthread])
+
+    AS_IF(
+      [test "x$ac_cv_header_pthread_h" = xyes && test "x$ac_cv_search_pthread_mutex_lock" != xno],
+      [AC_DEFINE(
+        [HAVE_ERROR_REGISTRY],
+        [1],
+        [Define to 1 to enable the registry of live errors.])
+
+      AS_IF(
+        [test "x$ac_cv_search_pthread_mutex_lock" != "xnone required"],
+        [AC_SUBST(
+          [ax_libcerror_pc_libs_private],
+          ["$ax_libcerror_pc_libs_private $ac_cv_search_pthread_mutex_lock"])
+        ])
+      ],
+      [ac_cv_enable_error_registry=no])
+    ])
+
+  dnl Check if the USDT probes should be disabled
+  AX_COMMON_ARG_DISABLE(
+    [usdt-probes],
+    [usdt_probes],
+    [USDT static tracepoints])
+
+  dnl Headers used in libcerror/libcerror_probes.h
+  AS_IF(
+    [test "x$ac_cv_enable_usdt_probes" != xno],
+    [AC_CHECK_HEADERS([sys/sdt.h])
+
+    AS_IF(
+      [test "x$ac_cv_header_sys_sdt_h" = xyes],
+      [AC_DEFINE(
+        [HAVE_USDT_PROBES],
+        [1],
+        [Define to 1 to enable the USDT static tracepoints.])
+      ],
+      [ac_cv_enable_usdt_probes=no])
+    ])
+
+  dnl Check for programs used in tests/test_probes.at
+  AC_CHECK_TOOL(
+    [READELF],
+    [readelf])
+
+  AC_SUBST(
+    [TESTS_USDT_PROBES],
+    [$ac_cv_enable_usdt_probes])
+
   dnl Wide character string functions used in libcerror/libcerror_error.c
   AS_IF(
     [test "x$ac_cv_enable_wide_character_type" != xno],
@@ -69,3 +275,29 @@ AC_DEFUN([AX_LIBCERROR_CHECK_DLL_SUPPORT],
     ])
   ])
 
+dnl Function to detect if cerrorprof dependencies are available
+AC_DEFUN([AX_CERRORPROF_CHECK_LOCAL],
+  [dnl Check if the profiling shim should be disabled
+  AX_COMMON_ARG_DISABLE(
+    [profiling-shim],
+    [profiling_shim],
+    [build of the LD_PRELOAD profiling shim libcerror-prof])
+
+  dnl Functions used in cerrorprof/cerrorprof.c
+  AS_IF(
+    [test "x$ac_cv_enable_profiling_shim" != xno],
+    [AX_LIBCERROR_CHECK_CC_ATOMIC
+
+    AS_IF(
+      [test "x$enable_shared" != xyes || test "x$lt_cv_prog_gnu_ld" != xyes || test "x$ac_cv_lib_dl_dlsym" != xyes || test "x$ac_cv_cc___atomic" != xyes],
+      [ac_cv_enable_profiling_shim=no])
+    ])
+
+  AM_CONDITIONAL(
+    [HAVE_PROFILING_SHIM],
+    [test "x$ac_cv_enable_profiling_shim" != xno])
+
+  AC_SUBST(
+    [TESTS_PROFILING_SHIM],
+    [$ac_cv_enable_profiling_shim])
+  ])
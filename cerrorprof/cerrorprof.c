@@ -0,0 +1,603 @@
+/*
+ * Profiling shim that is preloaded into programs that use libcerror
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* The shim is loaded with LD_PRELOAD before libcerror and interposes
+ * libcerror_error_set, libcerror_system_set_error and libcerror_error_free.
+ * The interposed functions call the functions of libcerror that are looked up
+ * with dlsym( RTLD_NEXT, ... ) and record the number of calls, the time spent,
+ * the depth of the errors and the addresses of the callers. The report is
+ * written to the file named by the LIBCERROR_PROF_OUTPUT environment variable
+ * or to stderr when the program exits.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <time.h>
+
+#define __USE_GNU
+#include <dlfcn.h>
+#undef __USE_GNU
+
+#include <libcerror.h>
+
+/* The number of interposed functions
+ */
+#define CERRORPROF_NUMBER_OF_FUNCTIONS			3
+
+#define CERRORPROF_FUNCTION_ERROR_SET			0
+#define CERRORPROF_FUNCTION_SYSTEM_SET_ERROR		1
+#define CERRORPROF_FUNCTION_ERROR_FREE			2
+
+/* The number of buckets of the depth histograms
+ * bucket 0 contains the depth of 0, bucket N the depths of 2^(N-1) up to 2^N
+ * the last bucket contains all larger depths
+ */
+#define CERRORPROF_NUMBER_OF_DEPTH_BUCKETS		16
+
+/* The number of callers that can be recorded, must be a power of 2
+ */
+#define CERRORPROF_MAXIMUM_NUMBER_OF_CALLERS		4096
+
+/* The number of callers in the report
+ */
+#define CERRORPROF_NUMBER_OF_REPORTED_CALLERS		32
+
+typedef struct cerrorprof_function cerrorprof_function_t;
+
+/* The statistics of an interposed function
+ */
+struct cerrorprof_function
+{
+	/* The name
+	 */
+	const char *name;
+
+	/* The number of calls
+	 */
+	uint64_t number_of_calls;
+
+	/* The time spent in nanoseconds
+	 */
+	uint64_t time;
+
+	/* The depth histogram
+	 * the depth after the message was set or the depth of the error that is freed
+	 */
+	uint64_t depth_counts[ CERRORPROF_NUMBER_OF_DEPTH_BUCKETS ];
+};
+
+typedef struct cerrorprof_caller cerrorprof_caller_t;
+
+/* A caller of an interposed function
+ */
+struct cerrorprof_caller
+{
+	/* The return address
+	 */
+	const void *address;
+
+	/* The function index
+	 */
+	int function_index;
+
+	/* The number of calls
+	 */
+	uint64_t number_of_calls;
+};
+
+static cerrorprof_function_t cerrorprof_functions[ CERRORPROF_NUMBER_OF_FUNCTIONS ] = {
+	{ "libcerror_error_set", 0, 0, { 0 } },
+	{ "libcerror_system_set_error", 0, 0, { 0 } },
+	{ "libcerror_error_free", 0, 0, { 0 } } };
+
+/* The callers are stored in an open addressing hash table by return address
+ */
+static cerrorprof_caller_t cerrorprof_callers[ CERRORPROF_MAXIMUM_NUMBER_OF_CALLERS ];
+
+/* The number of calls of which the caller could not be recorded
+ */
+static uint64_t cerrorprof_number_of_unrecorded_calls = 0;
+
+static void (*cerrorprof_real_error_vset)(libcerror_error_t **, int, int, const char *, va_list) = NULL;
+
+static void (*cerrorprof_real_system_vset_error)(libcerror_error_t **, int, int, uint32_t, const char *, va_list) = NULL;
+
+static void (*cerrorprof_real_error_free)(libcerror_error_t **) = NULL;
+
+static int (*cerrorprof_real_error_get_depth)(libcerror_error_t *, int *) = NULL;
+
+/* Retrieves a timestamp of the monotonic clock
+ * Returns the timestamp in nanoseconds or 0 if not available
+ */
+uint64_t cerrorprof_get_timestamp(
+          void )
+{
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+}
+
+/* Retrieves the depth of an error
+ * Returns the depth or 0 if not available
+ */
+int cerrorprof_get_depth(
+     libcerror_error_t *error )
+{
+	int depth = 0;
+
+	if( error == NULL )
+	{
+		return( 0 );
+	}
+	if( cerrorprof_real_error_get_depth == NULL )
+	{
+		cerrorprof_real_error_get_depth = dlsym(
+		                                   RTLD_NEXT,
+		                                   "libcerror_error_get_depth" );
+
+		if( cerrorprof_real_error_get_depth == NULL )
+		{
+			return( 0 );
+		}
+	}
+	if( cerrorprof_real_error_get_depth(
+	     error,
+	     &depth ) != 1 )
+	{
+		return( 0 );
+	}
+	return( depth );
+}
+
+/* Records a call of an interposed function
+ */
+void cerrorprof_record_call(
+      int function_index,
+      uint64_t start_time,
+      int depth,
+      const void *caller_address )
+{
+	cerrorprof_function_t *function = &( cerrorprof_functions[ function_index ] );
+	const void *address             = NULL;
+	uint64_t end_time               = cerrorprof_get_timestamp();
+	int bucket_index                = 0;
+	int caller_index                = 0;
+	int number_of_probes            = 0;
+
+	__atomic_fetch_add(
+	 &( function->number_of_calls ),
+	 1,
+	 __ATOMIC_RELAXED );
+
+	if( end_time > start_time )
+	{
+		__atomic_fetch_add(
+		 &( function->time ),
+		 end_time - start_time,
+		 __ATOMIC_RELAXED );
+	}
+	if( depth > 0 )
+	{
+		bucket_index = 32 - __builtin_clz(
+		                     (unsigned int) depth );
+
+		if( bucket_index >= CERRORPROF_NUMBER_OF_DEPTH_BUCKETS )
+		{
+			bucket_index = CERRORPROF_NUMBER_OF_DEPTH_BUCKETS - 1;
+		}
+	}
+	__atomic_fetch_add(
+	 &( function->depth_counts[ bucket_index ] ),
+	 1,
+	 __ATOMIC_RELAXED );
+
+	/* Find or claim the entry of the caller
+	 */
+	caller_index = (int) ( ( (uintptr_t) caller_address >> 2 ) & ( CERRORPROF_MAXIMUM_NUMBER_OF_CALLERS - 1 ) );
+
+	for( number_of_probes = 0;
+	     number_of_probes < CERRORPROF_MAXIMUM_NUMBER_OF_CALLERS;
+	     number_of_probes++ )
+	{
+		address = __atomic_load_n(
+		           &( cerrorprof_callers[ caller_index ].address ),
+		           __ATOMIC_ACQUIRE );
+
+		if( address == NULL )
+		{
+			if( __atomic_compare_exchange_n(
+			     &( cerrorprof_callers[ caller_index ].address ),
+			     &address,
+			     caller_address,
+			     0,
+			     __ATOMIC_ACQ_REL,
+			     __ATOMIC_ACQUIRE ) != 0 )
+			{
+				cerrorprof_callers[ caller_index ].function_index = function_index;
+
+				address = caller_address;
+			}
+		}
+		if( address == caller_address )
+		{
+			__atomic_fetch_add(
+			 &( cerrorprof_callers[ caller_index ].number_of_calls ),
+			 1,
+			 __ATOMIC_RELAXED );
+
+			return;
+		}
+		caller_index = ( caller_index + 1 ) & ( CERRORPROF_MAXIMUM_NUMBER_OF_CALLERS - 1 );
+	}
+	__atomic_fetch_add(
+	 &cerrorprof_number_of_unrecorded_calls,
+	 1,
+	 __ATOMIC_RELAXED );
+}
+
+/* Sets an error
+ * Interposes libcerror_error_set
+ */
+void libcerror_error_set(
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      const char *format_string,
+      ... )
+{
+	va_list argument_list;
+
+	uint64_t start_time = 0;
+
+	if( cerrorprof_real_error_vset == NULL )
+	{
+		cerrorprof_real_error_vset = dlsym(
+		                              RTLD_NEXT,
+		                              "libcerror_error_vset" );
+
+		if( cerrorprof_real_error_vset == NULL )
+		{
+			return;
+		}
+	}
+	start_time = cerrorprof_get_timestamp();
+
+	va_start(
+	 argument_list,
+	 format_string );
+
+	cerrorprof_real_error_vset(
+	 error,
+	 error_domain,
+	 error_code,
+	 format_string,
+	 argument_list );
+
+	va_end(
+	 argument_list );
+
+	cerrorprof_record_call(
+	 CERRORPROF_FUNCTION_ERROR_SET,
+	 start_time,
+	 ( error != NULL ) ? cerrorprof_get_depth( *error ) : 0,
+	 __builtin_return_address( 0 ) );
+}
+
+/* Sets an error and adds a system specific error string if possible
+ * Interposes libcerror_system_set_error
+ */
+void libcerror_system_set_error(
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      uint32_t system_error_code,
+      const char *format_string,
+      ... )
+{
+	va_list argument_list;
+
+	uint64_t start_time = 0;
+
+	if( cerrorprof_real_system_vset_error == NULL )
+	{
+		cerrorprof_real_system_vset_error = dlsym(
+		                                     RTLD_NEXT,
+		                                     "libcerror_system_vset_error" );
+
+		if( cerrorprof_real_system_vset_error == NULL )
+		{
+			return;
+		}
+	}
+	start_time = cerrorprof_get_timestamp();
+
+	va_start(
+	 argument_list,
+	 format_string );
+
+	cerrorprof_real_system_vset_error(
+	 error,
+	 error_domain,
+	 error_code,
+	 system_error_code,
+	 format_string,
+	 argument_list );
+
+	va_end(
+	 argument_list );
+
+	cerrorprof_record_call(
+	 CERRORPROF_FUNCTION_SYSTEM_SET_ERROR,
+	 start_time,
+	 ( error != NULL ) ? cerrorprof_get_depth( *error ) : 0,
+	 __builtin_return_address( 0 ) );
+}
+
+/* Frees an error
+ * Interposes libcerror_error_free
+ */
+void libcerror_error_free(
+      libcerror_error_t **error )
+{
+	uint64_t start_time = 0;
+	int depth           = 0;
+
+	if( cerrorprof_real_error_free == NULL )
+	{
+		cerrorprof_real_error_free = dlsym(
+		                              RTLD_NEXT,
+		                              "libcerror_error_free" );
+
+		if( cerrorprof_real_error_free == NULL )
+		{
+			return;
+		}
+	}
+	if( error != NULL )
+	{
+		depth = cerrorprof_get_depth(
+		         *error );
+	}
+	start_time = cerrorprof_get_timestamp();
+
+	cerrorprof_real_error_free(
+	 error );
+
+	cerrorprof_record_call(
+	 CERRORPROF_FUNCTION_ERROR_FREE,
+	 start_time,
+	 depth,
+	 __builtin_return_address( 0 ) );
+}
+
+/* Prints the report to a stream
+ */
+void cerrorprof_print_report(
+      FILE *stream )
+{
+	Dl_info caller_information;
+
+	cerrorprof_caller_t *reported_callers[ CERRORPROF_NUMBER_OF_REPORTED_CALLERS ];
+
+	cerrorprof_caller_t *caller     = NULL;
+	cerrorprof_function_t *function = NULL;
+	uint64_t average_time           = 0;
+	int bucket_index                = 0;
+	int caller_index                = 0;
+	int function_index              = 0;
+	int number_of_reported_callers  = 0;
+	int reported_caller_index       = 0;
+
+	fprintf(
+	 stream,
+	 "libcerror profile of process: %d\n\n",
+	 (int) getpid() );
+
+	fprintf(
+	 stream,
+	 "%-32s %16s %16s %16s\n",
+	 "Function",
+	 "Calls",
+	 "Time (ns)",
+	 "Average (ns)" );
+
+	for( function_index = 0;
+	     function_index < CERRORPROF_NUMBER_OF_FUNCTIONS;
+	     function_index++ )
+	{
+		function     = &( cerrorprof_functions[ function_index ] );
+		average_time = 0;
+
+		if( function->number_of_calls > 0 )
+		{
+			average_time = function->time / function->number_of_calls;
+		}
+		fprintf(
+		 stream,
+		 "%-32s %16" PRIu64 " %16" PRIu64 " %16" PRIu64 "\n",
+		 function->name,
+		 function->number_of_calls,
+		 function->time,
+		 average_time );
+	}
+	for( function_index = 0;
+	     function_index < CERRORPROF_NUMBER_OF_FUNCTIONS;
+	     function_index++ )
+	{
+		function = &( cerrorprof_functions[ function_index ] );
+
+		if( function->number_of_calls == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 stream,
+		 "\nDepth of %s:\n",
+		 function->name );
+
+		for( bucket_index = 0;
+		     bucket_index < CERRORPROF_NUMBER_OF_DEPTH_BUCKETS;
+		     bucket_index++ )
+		{
+			if( function->depth_counts[ bucket_index ] == 0 )
+			{
+				continue;
+			}
+			fprintf(
+			 stream,
+			 "\t>= %d\t: %" PRIu64 "\n",
+			 ( bucket_index == 0 ) ? 0 : 1 << ( bucket_index - 1 ),
+			 function->depth_counts[ bucket_index ] );
+		}
+	}
+	/* Select the callers with the most calls
+	 */
+	for( caller_index = 0;
+	     caller_index < CERRORPROF_MAXIMUM_NUMBER_OF_CALLERS;
+	     caller_index++ )
+	{
+		caller = &( cerrorprof_callers[ caller_index ] );
+
+		if( caller->address == NULL )
+		{
+			continue;
+		}
+		reported_caller_index = number_of_reported_callers;
+
+		while( ( reported_caller_index > 0 )
+		    && ( reported_callers[ reported_caller_index - 1 ]->number_of_calls < caller->number_of_calls ) )
+		{
+			if( reported_caller_index < CERRORPROF_NUMBER_OF_REPORTED_CALLERS )
+			{
+				reported_callers[ reported_caller_index ] = reported_callers[ reported_caller_index - 1 ];
+			}
+			reported_caller_index--;
+		}
+		if( reported_caller_index < CERRORPROF_NUMBER_OF_REPORTED_CALLERS )
+		{
+			reported_callers[ reported_caller_index ] = caller;
+
+			if( number_of_reported_callers < CERRORPROF_NUMBER_OF_REPORTED_CALLERS )
+			{
+				number_of_reported_callers++;
+			}
+		}
+	}
+	fprintf(
+	 stream,
+	 "\nCallers:\n" );
+
+	for( reported_caller_index = 0;
+	     reported_caller_index < number_of_reported_callers;
+	     reported_caller_index++ )
+	{
+		caller = reported_callers[ reported_caller_index ];
+
+		fprintf(
+		 stream,
+		 "\t%p\t%" PRIu64 "\t%s",
+		 caller->address,
+		 caller->number_of_calls,
+		 cerrorprof_functions[ caller->function_index ].name );
+
+		/* The symbol of the caller is only available if it is exported
+		 */
+		if( ( dladdr(
+		       caller->address,
+		       &caller_information ) != 0 )
+		 && ( caller_information.dli_fname != NULL ) )
+		{
+			if( caller_information.dli_sname != NULL )
+			{
+				fprintf(
+				 stream,
+				 "\tfrom %s+0x%lx",
+				 caller_information.dli_sname,
+				 (unsigned long) ( (uintptr_t) caller->address - (uintptr_t) caller_information.dli_saddr ) );
+			}
+			fprintf(
+			 stream,
+			 "\tin %s+0x%lx",
+			 caller_information.dli_fname,
+			 (unsigned long) ( (uintptr_t) caller->address - (uintptr_t) caller_information.dli_fbase ) );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	if( cerrorprof_number_of_unrecorded_calls > 0 )
+	{
+		fprintf(
+		 stream,
+		 "\tcalls with an unrecorded caller\t%" PRIu64 "\n",
+		 cerrorprof_number_of_unrecorded_calls );
+	}
+}
+
+/* Writes the report when the program exits
+ */
+__attribute__((destructor)) \
+void cerrorprof_finalize(
+      void )
+{
+	FILE *stream            = stderr;
+	const char *output_path = getenv(
+	                           "LIBCERROR_PROF_OUTPUT" );
+
+	if( ( output_path != NULL )
+	 && ( output_path[ 0 ] != 0 ) )
+	{
+		stream = fopen(
+		          output_path,
+		          "a" );
+
+		if( stream == NULL )
+		{
+			stream = stderr;
+		}
+	}
+	cerrorprof_print_report(
+	 stream );
+
+	if( stream != stderr )
+	{
+		fclose(
+		 stream );
+	}
+}
+
@@ -0,0 +1,344 @@
+/*
+ * Error call site functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
+#include "libcerror_callsite.h"
+#include "libcerror_definitions.h"
+#include "libcerror_error.h"
+#include "libcerror_registry.h"
+#include "libcerror_types.h"
+
+#if defined( HAVE_ERROR_STATISTICS )
+
+/* The registered call sites
+ * Call sites are registered when they are first hit and are never unregistered
+ * The call sites are static descriptors of the module that contains them, hence
+ * a module that uses LIBCERROR_ERROR_SET_AT must not be unloaded, e.g. by dlclose
+ */
+static libcerror_callsite_t *libcerror_callsite_list = NULL;
+
+/* Registers a call site
+ * Only the first caller registers the call site, hence a call site is registered once
+ */
+void libcerror_callsite_register(
+      libcerror_callsite_t *callsite,
+      const char *format_string )
+{
+	libcerror_callsite_t *next_callsite = NULL;
+	int is_registered                   = 0;
+
+	if( __atomic_load_n(
+	     &( callsite->is_registered ),
+	     __ATOMIC_ACQUIRE ) != 0 )
+	{
+		return;
+	}
+	if( __atomic_compare_exchange_n(
+	     &( callsite->is_registered ),
+	     &is_registered,
+	     1,
+	     0,
+	     __ATOMIC_ACQ_REL,
+	     __ATOMIC_ACQUIRE ) == 0 )
+	{
+		return;
+	}
+	callsite->format_string = format_string;
+
+	next_callsite = __atomic_load_n(
+	                 &libcerror_callsite_list,
+	                 __ATOMIC_RELAXED );
+
+	do
+	{
+		callsite->next_callsite = next_callsite;
+	}
+	while( __atomic_compare_exchange_n(
+	        &libcerror_callsite_list,
+	        &next_callsite,
+	        callsite,
+	        1,
+	        __ATOMIC_RELEASE,
+	        __ATOMIC_RELAXED ) == 0 );
+}
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#define VARARGS( function, error, callsite, type, argument ) \
+        function( error, callsite, type argument, ... )
+#define VASTART( argument_list, type, name ) \
+        va_start( argument_list, name )
+#define VAEND( argument_list ) \
+        va_end( argument_list )
+
+#elif defined( HAVE_VARARGS_H )
+#define VARARGS( function, error, callsite, type, argument ) \
+        function( error, callsite, va_alist ) va_dcl
+#define VASTART( argument_list, type, name ) \
+        { type name; va_start( argument_list ); name = va_arg( argument_list, type )
+#define VAEND( argument_list ) \
+        va_end( argument_list ); }
+
+#endif /* defined( HAVE_STDARG_H ) || defined( WINAPI ) */
+
+/* Sets an error with the error domain and code of a call site
+ * The call site is counted if the error statistics are available
+ * Use LIBCERROR_ERROR_SET_AT to declare the call site
+ */
+void VARARGS(
+      libcerror_error_set_callsite,
+      libcerror_error_t **error,
+      libcerror_callsite_t *callsite,
+      const char *,
+      format_string )
+{
+	va_list argument_list;
+
+#if defined( HAVE_ERROR_STATISTICS )
+	size_t message_data_size = 0;
+#endif
+
+	if( error == NULL )
+	{
+		return;
+	}
+	if( callsite == NULL )
+	{
+		return;
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	if( *error != NULL )
+	{
+		message_data_size = ( (libcerror_internal_error_t *) *error )->message_data_size;
+	}
+#endif
+	VASTART(
+	 argument_list,
+	 const char *,
+	 format_string );
+
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_callsite_register(
+	 callsite,
+	 format_string );
+#endif
+	libcerror_error_vset(
+	 error,
+	 callsite->error_domain,
+	 callsite->error_code,
+	 format_string,
+	 argument_list );
+
+	VAEND(
+	 argument_list );
+
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_registry_set_creation_site(
+	 *error,
+	 LIBCERROR_REGISTRY_RETURN_ADDRESS,
+	 callsite );
+#endif
+#if defined( HAVE_ERROR_STATISTICS )
+	__atomic_fetch_add(
+	 &( callsite->number_of_hits ),
+	 1,
+	 __ATOMIC_RELAXED );
+
+	if( ( *error != NULL )
+	 && ( ( (libcerror_internal_error_t *) *error )->message_data_size > message_data_size ) )
+	{
+		__atomic_fetch_add(
+		 &( callsite->number_of_bytes ),
+		 (uint64_t) ( ( (libcerror_internal_error_t *) *error )->message_data_size - message_data_size ) * sizeof( system_character_t ),
+		 __ATOMIC_RELAXED );
+	}
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+#undef VARARGS
+#undef VASTART
+#undef VAEND
+
+/* Retrieves the number of hits and bytes of a call site
+ * Returns 1 if successful, 0 if the error statistics are not available or -1 on error
+ */
+int libcerror_callsite_get_counts(
+     libcerror_callsite_t *callsite,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_bytes )
+{
+	if( callsite == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_bytes == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	*number_of_hits = __atomic_load_n(
+	                   &( callsite->number_of_hits ),
+	                   __ATOMIC_RELAXED );
+
+	*number_of_bytes = __atomic_load_n(
+	                    &( callsite->number_of_bytes ),
+	                    __ATOMIC_RELAXED );
+
+	return( 1 );
+#else
+	*number_of_hits  = 0;
+	*number_of_bytes = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Retrieves the call sites with the most hits
+ * The call sites are stored in order of their number of hits, starting with the most hits
+ * Call sites without hits are not stored
+ * Since the numbers of hits are read while other threads can update them, the order is approximate
+ * Returns 1 if successful, 0 if the error statistics are not available or -1 on error
+ */
+int libcerror_callsite_get_hottest(
+     libcerror_callsite_t **callsites,
+     int maximum_number_of_callsites,
+     int *number_of_callsites )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_callsite_t *callsite = NULL;
+	uint64_t number_of_hits        = 0;
+	int callsite_index             = 0;
+	int stored_number_of_callsites = 0;
+#endif
+
+	if( callsites == NULL )
+	{
+		return( -1 );
+	}
+	if( maximum_number_of_callsites < 0 )
+	{
+		return( -1 );
+	}
+	if( number_of_callsites == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	callsite = __atomic_load_n(
+	            &libcerror_callsite_list,
+	            __ATOMIC_ACQUIRE );
+
+	while( callsite != NULL )
+	{
+		number_of_hits = __atomic_load_n(
+		                  &( callsite->number_of_hits ),
+		                  __ATOMIC_RELAXED );
+
+		if( number_of_hits > 0 )
+		{
+			/* Insert the call site in the call sites ordered by number of hits
+			 */
+			callsite_index = stored_number_of_callsites;
+
+			while( ( callsite_index > 0 )
+			    && ( __atomic_load_n(
+			          &( callsites[ callsite_index - 1 ]->number_of_hits ),
+			          __ATOMIC_RELAXED ) < number_of_hits ) )
+			{
+				if( callsite_index < maximum_number_of_callsites )
+				{
+					callsites[ callsite_index ] = callsites[ callsite_index - 1 ];
+				}
+				callsite_index--;
+			}
+			if( callsite_index < maximum_number_of_callsites )
+			{
+				callsites[ callsite_index ] = callsite;
+
+				if( stored_number_of_callsites < maximum_number_of_callsites )
+				{
+					stored_number_of_callsites++;
+				}
+			}
+		}
+		callsite = callsite->next_callsite;
+	}
+	*number_of_callsites = stored_number_of_callsites;
+
+	return( 1 );
+#else
+	*number_of_callsites = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Resets the number of hits and bytes of all the call sites
+ * Returns 1 if successful, 0 if the error statistics are not available or -1 on error
+ */
+int libcerror_callsite_reset(
+     void )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_callsite_t *callsite = NULL;
+
+	callsite = __atomic_load_n(
+	            &libcerror_callsite_list,
+	            __ATOMIC_ACQUIRE );
+
+	while( callsite != NULL )
+	{
+		__atomic_store_n(
+		 &( callsite->number_of_hits ),
+		 0,
+		 __ATOMIC_RELAXED );
+
+		__atomic_store_n(
+		 &( callsite->number_of_bytes ),
+		 0,
+		 __ATOMIC_RELAXED );
+
+		callsite = callsite->next_callsite;
+	}
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
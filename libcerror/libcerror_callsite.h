@@ -0,0 +1,95 @@
+/*
+ * Error call site functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_CALLSITE_H )
+#define _LIBCERROR_CALLSITE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcerror_definitions.h"
+#include "libcerror_extern.h"
+#include "libcerror_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_ERROR_STATISTICS )
+
+void libcerror_callsite_register(
+      libcerror_callsite_t *callsite,
+      const char *format_string );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+
+LIBCERROR_EXTERN \
+void libcerror_error_set_callsite(
+      libcerror_error_t **error,
+      libcerror_callsite_t *callsite,
+      const char *format_string,
+      ... );
+
+/* The name of the function of a call site
+ */
+#if defined( _MSC_VER )
+#define LIBCERROR_CALLSITE_FUNCTION \
+	__FUNCTION__
+#else
+#define LIBCERROR_CALLSITE_FUNCTION \
+	__func__
+#endif
+
+/* Sets an error and counts the call site
+ * Declares a static call site descriptor with the error domain, code, source file, line and function
+ * The format string and its arguments are passed as the remaining arguments
+ */
+#define LIBCERROR_ERROR_SET_AT( error, error_domain, error_code, ... ) \
+	do \
+	{ \
+		static libcerror_callsite_t libcerror_error_callsite = { \
+			error_domain, error_code, NULL, __FILE__, __LINE__, LIBCERROR_CALLSITE_FUNCTION, 0, 0, NULL, 0 }; \
+		libcerror_error_set_callsite( error, &libcerror_error_callsite, __VA_ARGS__ ); \
+	} \
+	while( 0 )
+
+LIBCERROR_EXTERN \
+int libcerror_callsite_get_counts(
+     libcerror_callsite_t *callsite,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_bytes );
+
+LIBCERROR_EXTERN \
+int libcerror_callsite_get_hottest(
+     libcerror_callsite_t **callsites,
+     int maximum_number_of_callsites,
+     int *number_of_callsites );
+
+LIBCERROR_EXTERN \
+int libcerror_callsite_reset(
+     void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_CALLSITE_H ) */
+
@@ -36,10 +36,154 @@
 
 #include <errno.h>
 
+#if defined( HAVE_SYS_UIO_H )
+#include <sys/uio.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( _MSC_VER )
+#include <io.h>
+#endif
+
 #include "libcerror_definitions.h"
 #include "libcerror_error.h"
+#include "libcerror_format.h"
+#include "libcerror_json.h"
+#include "libcerror_lifetime.h"
+#include "libcerror_memory.h"
+#include "libcerror_pool.h"
+#include "libcerror_probes.h"
+#include "libcerror_registry.h"
+#include "libcerror_statistics.h"
+#include "libcerror_support.h"
+#include "libcerror_trace.h"
 #include "libcerror_types.h"
 
+/* The stream is locked once per backtrace if the unlocked stream functions are available
+ */
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE ) && defined( HAVE_FWRITE_UNLOCKED )
+#define libcerror_error_fwrite( data, size, stream ) \
+	fwrite_unlocked( data, 1, size, stream )
+#else
+#define libcerror_error_fwrite( data, size, stream ) \
+	fwrite( data, 1, size, stream )
+#endif
+
+#if defined( _MSC_VER )
+#define libcerror_error_write( file_descriptor, data, size ) \
+	_write( file_descriptor, data, (unsigned int) size )
+#else
+#define libcerror_error_write( file_descriptor, data, size ) \
+	write( file_descriptor, data, size )
+#endif
+
+#if defined( LIBCERROR_THREAD_LOCAL )
+
+typedef struct libcerror_reserve_error libcerror_reserve_error_t;
+
+/* The reserve error
+ * The error, its message index and message data are stored in a fixed size block of memory
+ */
+struct libcerror_reserve_error
+{
+	/* The error
+	 */
+	union
+	{
+		/* The error
+		 */
+		libcerror_internal_error_t internal_error;
+
+		/* The block of memory
+		 */
+		uint8_t data[ LIBCERROR_RESERVE_SIZE ];
+
+	} arena;
+
+	/* Value to indicate the reserve error is used
+	 */
+	int is_used;
+};
+
+/* The reserve error of the current thread
+ */
+static LIBCERROR_THREAD_LOCAL libcerror_reserve_error_t libcerror_error_reserve;
+
+#endif /* defined( LIBCERROR_THREAD_LOCAL ) */
+
+/* Determines the size of the single block of memory of an error
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_arena_size(
+     int number_of_messages,
+     size_t message_data_size,
+     size_t *arena_size )
+{
+	size_t message_index_entry_size = 0;
+
+	if( number_of_messages < 0 )
+	{
+		return( -1 );
+	}
+	if( arena_size == NULL )
+	{
+		return( -1 );
+	}
+	message_index_entry_size = sizeof( system_character_t * ) + sizeof( size_t ) + sizeof( uint32_t );
+
+	if( (size_t) number_of_messages > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / message_index_entry_size ) )
+	{
+		return( -1 );
+	}
+	if( message_data_size > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
+	{
+		return( -1 );
+	}
+	*arena_size = sizeof( libcerror_internal_error_t )
+	            + ( message_index_entry_size * number_of_messages )
+	            + ( sizeof( system_character_t ) * message_data_size );
+
+	if( *arena_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the location of the message index and message data of an error
+ * based on its allocated number of messages
+ */
+void libcerror_error_set_arena_layout(
+      libcerror_internal_error_t *internal_error )
+{
+	uint8_t *arena = NULL;
+	size_t offset  = 0;
+
+	if( internal_error == NULL )
+	{
+		return;
+	}
+	arena  = (uint8_t *) internal_error;
+	offset = sizeof( libcerror_internal_error_t );
+
+	internal_error->messages = (system_character_t **) &( arena[ offset ] );
+
+	offset += sizeof( system_character_t * ) * internal_error->number_of_allocated_messages;
+
+	internal_error->sizes = (size_t *) &( arena[ offset ] );
+
+	offset += sizeof( size_t ) * internal_error->number_of_allocated_messages;
+
+	internal_error->flags = (uint32_t *) &( arena[ offset ] );
+
+	offset += sizeof( uint32_t ) * internal_error->number_of_allocated_messages;
+
+	internal_error->message_data = (system_character_t *) &( arena[ offset ] );
+}
+
 /* Creates an error
  * Returns 1 if successful or -1 on error
  */
@@ -49,6 +193,7 @@ int libcerror_error_initialize(
      int error_code )
 {
 	libcerror_internal_error_t *internal_error = NULL;
+	size_t arena_size                          = 0;
 
 	if( error == NULL )
 	{
@@ -58,22 +203,132 @@ int libcerror_error_initialize(
 	{
 		return( -1 );
 	}
-	internal_error = memory_allocate_structure(
-	                  libcerror_internal_error_t );
+	/* A block from the pool retains its allocated number of messages and message data size
+	 */
+	internal_error = (libcerror_internal_error_t *) libcerror_pool_get_block();
 
 	if( internal_error == NULL )
 	{
-		return( -1 );
+		/* Allocate room for the initial messages so that setting an error
+		 * does not require a reallocation in most cases
+		 */
+		if( libcerror_error_get_arena_size(
+		     LIBCERROR_INITIAL_NUMBER_OF_MESSAGES,
+		     LIBCERROR_INITIAL_MESSAGE_DATA_SIZE,
+		     &arena_size ) != 1 )
+		{
+			return( -1 );
+		}
+		internal_error = (libcerror_internal_error_t *) libcerror_memory_allocate(
+		                                                           arena_size );
+
+		if( internal_error == NULL )
+		{
+			return( -1 );
+		}
+		internal_error->number_of_allocated_messages = LIBCERROR_INITIAL_NUMBER_OF_MESSAGES;
+		internal_error->allocated_message_data_size  = LIBCERROR_INITIAL_MESSAGE_DATA_SIZE;
+
+#if defined( HAVE_ERROR_STATISTICS )
+		libcerror_statistics_add_allocated_message_data_size(
+		 sizeof( system_character_t ) * LIBCERROR_INITIAL_MESSAGE_DATA_SIZE );
+#endif
 	}
 	internal_error->domain             = error_domain;
 	internal_error->code               = error_code;
 	internal_error->number_of_messages = 0;
-	internal_error->messages           = NULL;
-	internal_error->sizes              = NULL;
+	internal_error->message_data_size  = 0;
+	internal_error->is_reserve         = 0;
+
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	internal_error->creation_time      = libcerror_lifetime_get_timestamp();
+#endif
+#if defined( HAVE_ERROR_REGISTRY )
+	internal_error->creation_address   = NULL;
+	internal_error->creation_callsite  = NULL;
+#endif
+	libcerror_error_set_arena_layout(
+	 internal_error );
+
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_registry_insert(
+	 internal_error );
+#endif
+
+	LIBCERROR_PROBE_ERROR_INITIALIZE(
+	 error_domain,
+	 error_code );
+
+	*error = (libcerror_error_t *) internal_error;
+
+	return( 1 );
+}
+
+/* Creates the reserve error
+ * The reserve error is used when there is insufficient memory to create an error
+ * and requires no allocation, there is a single reserve error per thread
+ * Returns 1 if successful, 0 if the reserve error is not available or -1 on error
+ */
+int libcerror_error_initialize_reserve(
+     libcerror_error_t **error )
+{
+#if defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_internal_error_t *internal_error = NULL;
+	size_t message_index_size                  = 0;
+#endif
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	if( *error != NULL )
+	{
+		return( -1 );
+	}
+#if defined( LIBCERROR_THREAD_LOCAL )
+	if( libcerror_error_reserve.is_used != 0 )
+	{
+		return( 0 );
+	}
+	if( libcerror_error_get_arena_size(
+	     LIBCERROR_RESERVE_NUMBER_OF_MESSAGES,
+	     0,
+	     &message_index_size ) != 1 )
+	{
+		return( -1 );
+	}
+	internal_error = &( libcerror_error_reserve.arena.internal_error );
+
+	internal_error->domain                       = LIBCERROR_ERROR_DOMAIN_MEMORY;
+	internal_error->code                         = LIBCERROR_MEMORY_ERROR_INSUFFICIENT;
+	internal_error->number_of_messages           = 0;
+	internal_error->number_of_allocated_messages = LIBCERROR_RESERVE_NUMBER_OF_MESSAGES;
+	internal_error->message_data_size            = 0;
+	internal_error->allocated_message_data_size  = ( LIBCERROR_RESERVE_SIZE - message_index_size ) / sizeof( system_character_t );
+	internal_error->is_reserve                   = 1;
+
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	internal_error->creation_time                = libcerror_lifetime_get_timestamp();
+#endif
+#if defined( HAVE_ERROR_REGISTRY )
+	/* The reserve error is not allocated, hence it is not a live error
+	 */
+	internal_error->is_live                      = 0;
+	internal_error->creation_address             = NULL;
+	internal_error->creation_callsite            = NULL;
+#endif
+
+	libcerror_error_set_arena_layout(
+	 internal_error );
+
+	libcerror_error_reserve.is_used = 1;
 
 	*error = (libcerror_error_t *) internal_error;
 
 	return( 1 );
+#else
+	return( 0 );
+#endif
 }
 
 /* Free an error and its elements
@@ -82,7 +337,7 @@ void libcerror_error_free(
       libcerror_error_t **error )
 {
 	libcerror_internal_error_t *internal_error = NULL;
-	int message_index                          = 0;
+	size_t arena_size                          = 0;
 
 	if( error == NULL )
 	{
@@ -91,125 +346,631 @@ void libcerror_error_free(
 	if( *error != NULL )
 	{
 		internal_error = (libcerror_internal_error_t *) *error;
+		*error         = NULL;
+
+		LIBCERROR_PROBE_ERROR_FREE(
+		 internal_error );
 
-		if( internal_error->messages != NULL )
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+		libcerror_lifetime_record(
+		 internal_error->creation_time,
+		 internal_error->number_of_messages );
+#endif
+#if defined( HAVE_ERROR_REGISTRY )
+		libcerror_registry_remove(
+		 internal_error );
+#endif
+
+		/* The reserve error is not allocated, its block of memory is made available again
+		 */
+		if( internal_error->is_reserve != 0 )
 		{
-			for( message_index = 0;
-			     message_index < internal_error->number_of_messages;
-			     message_index++ )
-			{
-				if( internal_error->messages[ message_index ] != NULL )
-				{
-					memory_free(
-					 internal_error->messages[ message_index ] );
-				}
-			}
-			memory_free(
-			 internal_error->messages );
+#if defined( LIBCERROR_THREAD_LOCAL )
+			( (libcerror_reserve_error_t *) internal_error )->is_used = 0;
+#endif
+			return;
 		}
-		if( internal_error->sizes != NULL )
+		/* The messages are stored in the same block of memory as the error
+		 */
+		if( libcerror_error_get_arena_size(
+		     internal_error->number_of_allocated_messages,
+		     internal_error->allocated_message_data_size,
+		     &arena_size ) == 1 )
 		{
-			memory_free(
-			 internal_error->sizes );
+			if( libcerror_pool_put_block(
+			     internal_error,
+			     arena_size ) == 1 )
+			{
+				return;
+			}
 		}
-		memory_free(
-		 *error );
-
-		*error = NULL;
+		libcerror_memory_free(
+		 internal_error );
 	}
 }
 
-/* Resizes an error
+/* Resets an error
+ * Clears the error domain, code and messages but keeps the allocated memory,
+ * so that the error can be reused by libcerror_error_set without allocating
  * Returns 1 if successful or -1 on error
  */
-int libcerror_error_resize(
-     libcerror_internal_error_t *internal_error )
+int libcerror_error_reset(
+     libcerror_error_t *error )
 {
-	void *reallocation     = NULL;
-	int message_index      = 0;
-	int number_of_messages = 0;
+	libcerror_internal_error_t *internal_error = NULL;
 
-	if( internal_error == NULL )
+	if( error == NULL )
 	{
 		return( -1 );
 	}
-	message_index      = internal_error->number_of_messages;
-	number_of_messages = internal_error->number_of_messages + 1;
+	internal_error = (libcerror_internal_error_t *) error;
 
-	reallocation = memory_reallocate(
-	                internal_error->messages,
-	                sizeof( system_character_t * ) * number_of_messages );
+	internal_error->domain             = 0;
+	internal_error->code               = 0;
+	internal_error->number_of_messages = 0;
+	internal_error->message_data_size  = 0;
 
-	if( reallocation == NULL )
+	return( 1 );
+}
+
+/* Retrieves the depth of an error
+ * The depth is the number of messages in the back trace
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_depth(
+     libcerror_error_t *error,
+     int *depth )
+{
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	if( depth == NULL )
 	{
 		return( -1 );
 	}
-	internal_error->messages = (system_character_t **) reallocation;
+	*depth = ( (libcerror_internal_error_t *) error )->number_of_messages;
+
+	return( 1 );
+}
 
-	internal_error->messages[ message_index ] = NULL;
+/* Truncates an error to a previously retrieved depth
+ * The messages beyond the depth are removed, their memory is kept for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_truncate(
+     libcerror_error_t *error,
+     int depth )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+	intptr_t message_data_start_address        = 0;
+	intptr_t message_string_address            = 0;
+	size_t message_data_end_offset             = 0;
+	size_t message_data_size                   = 0;
+	int message_index                          = 0;
 
-	reallocation = memory_reallocate(
-	                internal_error->sizes,
-	                sizeof( size_t ) * number_of_messages );
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
 
-	if( reallocation == NULL )
+	if( ( depth < 0 )
+	 || ( depth > internal_error->number_of_messages ) )
 	{
 		return( -1 );
 	}
-	internal_error->sizes = (size_t *) reallocation;
+	/* The message data in use ends after the last remaining message string
+	 * that is stored in the message data
+	 */
+	message_data_start_address = (intptr_t) internal_error->message_data;
+
+	for( message_index = 0;
+	     message_index < depth;
+	     message_index++ )
+	{
+		message_string_address = (intptr_t) internal_error->messages[ message_index ];
 
-	internal_error->sizes[ message_index ] = 0;
+		if( ( message_string_address >= message_data_start_address )
+		 && ( message_string_address < ( message_data_start_address + (intptr_t) ( sizeof( system_character_t ) * internal_error->message_data_size ) ) ) )
+		{
+			message_data_end_offset = ( (size_t) ( message_string_address - message_data_start_address ) / sizeof( system_character_t ) )
+			                        + internal_error->sizes[ message_index ];
 
-	internal_error->number_of_messages += 1;
+			if( message_data_end_offset > message_data_size )
+			{
+				message_data_size = message_data_end_offset;
+			}
+		}
+	}
+	internal_error->number_of_messages = depth;
+	internal_error->message_data_size  = message_data_size;
 
 	return( 1 );
 }
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+/* Determines if an error is the reserve error
+ * Returns 1 if the error is the reserve error or 0 if not
+ */
+int libcerror_error_is_reserve(
+     libcerror_internal_error_t *internal_error )
+{
+	if( internal_error == NULL )
+	{
+		return( 0 );
+	}
+	if( internal_error->is_reserve != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
 
-/* Retrieves the format string as a system string
+/* Resizes an error
+ * The error, its message index and message data are stored in a single block of memory
+ * hence the error can move when resized and the message strings are relocated accordingly
+ * The number of messages and message data size are grown geometrically
+ * Returns 1 if successful or -1 on error
  */
-void libcerror_error_get_system_format_string(
-      const char *format_string,
-      size_t format_string_length,
-      system_character_t **system_format_string )
+int libcerror_error_resize(
+     libcerror_internal_error_t **internal_error,
+     int number_of_messages,
+     size_t message_data_size )
 {
-	void *reallocation               = NULL;
-	size_t next_format_string_length = 0;
-	int print_count                  = 0;
+	libcerror_internal_error_t *safe_internal_error = NULL;
+	uint8_t *arena                                   = NULL;
+	void *reallocation                               = NULL;
+	intptr_t message_data_end_address                = 0;
+	intptr_t message_data_start_address              = 0;
+	intptr_t message_string_address                  = 0;
+	size_t arena_size                                = 0;
+	size_t flags_offset                              = 0;
+	size_t message_data_offset                       = 0;
+	size_t sizes_offset                              = 0;
+	int message_index                                = 0;
 
-#if defined( __BORLANDC__ ) || defined( _MSC_VER )
-	size_t string_index              = 0;
-#endif
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	safe_internal_error = *internal_error;
 
-	if( format_string == NULL )
+	if( safe_internal_error == NULL )
 	{
-		return;
+		return( -1 );
 	}
-	if( format_string_length > (size_t) SSIZE_MAX )
+	if( number_of_messages < 0 )
 	{
-		return;
+		return( -1 );
 	}
-	if( system_format_string == NULL )
+	if( ( number_of_messages <= safe_internal_error->number_of_allocated_messages )
+	 && ( message_data_size <= safe_internal_error->allocated_message_data_size ) )
 	{
-		return;
+		return( 1 );
 	}
-	next_format_string_length = format_string_length + 1;
-
-	do
+	/* The reserve error cannot be reallocated
+	 */
+	if( safe_internal_error->is_reserve != 0 )
 	{
-		if( next_format_string_length >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
-		{
-			next_format_string_length = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
-		}
-		reallocation = memory_reallocate(
-		                *system_format_string,
-		                sizeof( system_character_t ) * next_format_string_length );
+		return( -1 );
+	}
+	/* Grow geometrically to amortize the cost of the reallocations
+	 */
+	if( number_of_messages <= safe_internal_error->number_of_allocated_messages )
+	{
+		number_of_messages = safe_internal_error->number_of_allocated_messages;
+	}
+	else if( ( safe_internal_error->number_of_allocated_messages < ( INT_MAX / 2 ) )
+	      && ( number_of_messages < ( safe_internal_error->number_of_allocated_messages * 2 ) ) )
+	{
+		number_of_messages = safe_internal_error->number_of_allocated_messages * 2;
+	}
+	if( number_of_messages < LIBCERROR_INITIAL_NUMBER_OF_MESSAGES )
+	{
+		number_of_messages = LIBCERROR_INITIAL_NUMBER_OF_MESSAGES;
+	}
+	if( message_data_size <= safe_internal_error->allocated_message_data_size )
+	{
+		message_data_size = safe_internal_error->allocated_message_data_size;
+	}
+	else if( ( safe_internal_error->allocated_message_data_size < ( MEMORY_MAXIMUM_ALLOCATION_SIZE / ( 2 * sizeof( system_character_t ) ) ) )
+	      && ( message_data_size < ( safe_internal_error->allocated_message_data_size * 2 ) ) )
+	{
+		message_data_size = safe_internal_error->allocated_message_data_size * 2;
+	}
+	if( message_data_size < LIBCERROR_INITIAL_MESSAGE_DATA_SIZE )
+	{
+		message_data_size = LIBCERROR_INITIAL_MESSAGE_DATA_SIZE;
+	}
+	if( libcerror_error_get_arena_size(
+	     number_of_messages,
+	     message_data_size,
+	     &arena_size ) != 1 )
+	{
+		return( -1 );
+	}
+	/* Determine the location of the sizes, flags and message data before reallocation
+	 */
+	sizes_offset = sizeof( libcerror_internal_error_t )
+	             + ( sizeof( system_character_t * ) * safe_internal_error->number_of_allocated_messages );
 
-		if( reallocation == NULL )
-		{
-			memory_free(
-			 *system_format_string );
+	flags_offset = sizes_offset
+	             + ( sizeof( size_t ) * safe_internal_error->number_of_allocated_messages );
+
+	message_data_offset = flags_offset
+	                    + ( sizeof( uint32_t ) * safe_internal_error->number_of_allocated_messages );
+
+	message_data_start_address = (intptr_t) safe_internal_error->message_data;
+	message_data_end_address   = message_data_start_address
+	                           + (intptr_t) ( sizeof( system_character_t ) * safe_internal_error->allocated_message_data_size );
+
+#if defined( HAVE_ERROR_REGISTRY )
+	/* The live error registry references the error by address
+	 */
+	libcerror_registry_remove(
+	 safe_internal_error );
+#endif
+	reallocation = libcerror_memory_reallocate(
+	                safe_internal_error,
+	                arena_size );
+
+	if( reallocation == NULL )
+	{
+#if defined( HAVE_ERROR_REGISTRY )
+		libcerror_registry_insert(
+		 safe_internal_error );
+#endif
+		return( -1 );
+	}
+	safe_internal_error = (libcerror_internal_error_t *) reallocation;
+	arena               = (uint8_t *) reallocation;
+
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_registry_insert(
+	 safe_internal_error );
+#endif
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_add_allocated_message_data_size(
+	 sizeof( system_character_t ) * ( message_data_size - safe_internal_error->allocated_message_data_size ) );
+#endif
+
+	safe_internal_error->number_of_allocated_messages = number_of_messages;
+	safe_internal_error->allocated_message_data_size  = message_data_size;
+
+	libcerror_error_set_arena_layout(
+	 safe_internal_error );
+
+	/* The message index entries and message data only move upwards,
+	 * hence move the message data first, then the flags and then the sizes
+	 */
+	if( safe_internal_error->message_data_size > 0 )
+	{
+		memory_move(
+		 safe_internal_error->message_data,
+		 &( arena[ message_data_offset ] ),
+		 sizeof( system_character_t ) * safe_internal_error->message_data_size );
+	}
+	if( safe_internal_error->number_of_messages > 0 )
+	{
+		memory_move(
+		 safe_internal_error->flags,
+		 &( arena[ flags_offset ] ),
+		 sizeof( uint32_t ) * safe_internal_error->number_of_messages );
+
+		memory_move(
+		 safe_internal_error->sizes,
+		 &( arena[ sizes_offset ] ),
+		 sizeof( size_t ) * safe_internal_error->number_of_messages );
+	}
+	/* Relocate the message strings that are stored in the message data
+	 */
+	for( message_index = 0;
+	     message_index < safe_internal_error->number_of_messages;
+	     message_index++ )
+	{
+		message_string_address = (intptr_t) safe_internal_error->messages[ message_index ];
+
+		if( ( message_string_address >= message_data_start_address )
+		 && ( message_string_address < message_data_end_address ) )
+		{
+			safe_internal_error->messages[ message_index ] = (system_character_t *) &( ( (uint8_t *) safe_internal_error->message_data )[ message_string_address - message_data_start_address ] );
+		}
+	}
+	*internal_error = safe_internal_error;
+
+	return( 1 );
+}
+
+/* Appends a message string to an error
+ * A static message string is referenced instead of copied into the message data
+ * The message string is truncated if it does not fit in LIBCERROR_MESSAGE_MAXIMUM_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_append_message(
+     libcerror_internal_error_t **internal_error,
+     const system_character_t *message_string,
+     size_t message_string_length,
+     uint32_t message_flags )
+{
+	libcerror_internal_error_t *safe_internal_error = NULL;
+	system_character_t *error_string                = NULL;
+	size_t error_string_size                        = 0;
+	int message_index                               = 0;
+
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( message_string == NULL )
+	{
+		return( -1 );
+	}
+	if( message_string_length > (size_t) SSIZE_MAX )
+	{
+		return( -1 );
+	}
+	safe_internal_error = *internal_error;
+
+	if( safe_internal_error == NULL )
+	{
+		return( -1 );
+	}
+	message_index = safe_internal_error->number_of_messages;
+
+	if( ( message_flags & LIBCERROR_MESSAGE_FLAG_STATIC ) != 0 )
+	{
+		if( libcerror_error_resize(
+		     &safe_internal_error,
+		     message_index + 1,
+		     safe_internal_error->message_data_size ) != 1 )
+		{
+			return( -1 );
+		}
+		error_string      = (system_character_t *) message_string;
+		error_string_size = message_string_length + 1;
+	}
+	else
+	{
+		error_string_size = message_string_length + 1;
+
+		if( error_string_size > LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		{
+			error_string_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+		}
+		if( libcerror_error_resize(
+		     &safe_internal_error,
+		     message_index + 1,
+		     safe_internal_error->message_data_size + error_string_size ) != 1 )
+		{
+			return( -1 );
+		}
+		error_string = &( safe_internal_error->message_data[ safe_internal_error->message_data_size ] );
+
+		if( memory_copy(
+		     error_string,
+		     message_string,
+		     sizeof( system_character_t ) * ( error_string_size - 1 ) ) == NULL )
+		{
+			*internal_error = safe_internal_error;
+
+			return( -1 );
+		}
+		error_string[ error_string_size - 1 ] = 0;
+
+		if( message_string_length >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		{
+			error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 4 ] = (system_character_t) '.';
+			error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 3 ] = (system_character_t) '.';
+			error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 2 ] = (system_character_t) '.';
+
+#if defined( HAVE_ERROR_STATISTICS )
+			libcerror_statistics_increment_truncated_messages();
+#endif
+		}
+		safe_internal_error->message_data_size += error_string_size;
+	}
+	safe_internal_error->messages[ message_index ] = error_string;
+	safe_internal_error->sizes[ message_index ]    = error_string_size;
+	safe_internal_error->flags[ message_index ]    = message_flags;
+
+	safe_internal_error->number_of_messages += 1;
+
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_update_maximum_depth(
+	 safe_internal_error->number_of_messages );
+#endif
+	*internal_error = safe_internal_error;
+
+	return( 1 );
+}
+
+/* Appends a message to the reserve error
+ * The message string is formatted into the remaining message data of the reserve error
+ * and truncated if it does not fit
+ * Returns 1 if successful, 0 if there is no room for the message or -1 on error
+ */
+int libcerror_error_append_reserve_message(
+     libcerror_internal_error_t *internal_error,
+     const system_character_t *format_string,
+     va_list argument_list )
+{
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->is_reserve == 0 )
+	{
+		return( -1 );
+	}
+	return( libcerror_error_append_truncated_message(
+	         internal_error,
+	         format_string,
+	         argument_list ) );
+}
+
+/* Appends a message to an error without resizing it
+ * The message string is formatted into the remaining message data of the error
+ * and truncated if it does not fit
+ * Returns 1 if successful, 0 if there is no room for the message or -1 on error
+ */
+int libcerror_error_append_truncated_message(
+     libcerror_internal_error_t *internal_error,
+     const system_character_t *format_string,
+     va_list argument_list )
+{
+	system_character_t *error_string = NULL;
+	size_t error_string_size         = 0;
+	size_t message_size              = 0;
+	int message_index                = 0;
+	int print_count                  = 0;
+
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( format_string == NULL )
+	{
+		return( -1 );
+	}
+	message_index = internal_error->number_of_messages;
+
+	if( message_index >= internal_error->number_of_allocated_messages )
+	{
+		return( 0 );
+	}
+	message_size = internal_error->allocated_message_data_size - internal_error->message_data_size;
+
+	if( message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+	{
+		message_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+	}
+	/* Room for at least "..." and the end-of-string character
+	 */
+	if( message_size < 4 )
+	{
+		return( 0 );
+	}
+	error_string = &( internal_error->message_data[ internal_error->message_data_size ] );
+
+	print_count = system_string_vsnprintf(
+	               error_string,
+	               message_size,
+	               format_string,
+	               argument_list );
+
+	if( ( print_count <= -1 )
+	 || ( (size_t) print_count >= message_size ) )
+	{
+		error_string[ message_size - 4 ] = (system_character_t) '.';
+		error_string[ message_size - 3 ] = (system_character_t) '.';
+		error_string[ message_size - 2 ] = (system_character_t) '.';
+		error_string[ message_size - 1 ] = 0;
+		error_string_size                = message_size;
+	}
+	else
+	{
+		error_string_size = (size_t) print_count + 1;
+	}
+	internal_error->messages[ message_index ] = error_string;
+	internal_error->sizes[ message_index ]    = error_string_size;
+	internal_error->flags[ message_index ]    = 0;
+
+	internal_error->number_of_messages += 1;
+	internal_error->message_data_size  += error_string_size;
+
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_update_maximum_depth(
+	 internal_error->number_of_messages );
+#endif
+	return( 1 );
+}
+
+/* Notifies the probes and the trace callback that a message was set on an error
+ * The system error code is only used if is_system_error is non-zero
+ */
+void libcerror_error_notify_set(
+      libcerror_error_t *error,
+      int error_domain,
+      int error_code,
+      int is_system_error,
+      uint32_t system_error_code )
+{
+	if( error == NULL )
+	{
+		return;
+	}
+	if( is_system_error == 0 )
+	{
+		LIBCERROR_PROBE_ERROR_SET(
+		 error_domain,
+		 error_code,
+		 (libcerror_internal_error_t *) error );
+
+		system_error_code = 0;
+	}
+	else
+	{
+		LIBCERROR_PROBE_SYSTEM_SET_ERROR(
+		 error_domain,
+		 error_code,
+		 (libcerror_internal_error_t *) error,
+		 system_error_code );
+	}
+	if( libcerror_trace_callback != NULL )
+	{
+		libcerror_trace_error(
+		 error,
+		 error_domain,
+		 error_code,
+		 system_error_code );
+	}
+}
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Retrieves the format string as a system string
+ */
+void libcerror_error_get_system_format_string(
+      const char *format_string,
+      size_t format_string_length,
+      system_character_t **system_format_string )
+{
+	void *reallocation               = NULL;
+	size_t next_format_string_length = 0;
+	int print_count                  = 0;
+
+#if defined( __BORLANDC__ ) || defined( _MSC_VER )
+	size_t string_index              = 0;
+#endif
+
+	if( format_string == NULL )
+	{
+		return;
+	}
+	if( format_string_length > (size_t) SSIZE_MAX )
+	{
+		return;
+	}
+	if( system_format_string == NULL )
+	{
+		return;
+	}
+	next_format_string_length = format_string_length + 1;
+
+	do
+	{
+		if( next_format_string_length >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		{
+			next_format_string_length = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+		}
+		reallocation = libcerror_memory_reallocate(
+		                *system_format_string,
+		                sizeof( system_character_t ) * next_format_string_length );
+
+		if( reallocation == NULL )
+		{
+			libcerror_memory_free(
+			 *system_format_string );
 
 			*system_format_string = NULL;
 
@@ -245,7 +1006,7 @@ void libcerror_error_get_system_format_string(
 		if( next_format_string_length >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
 		{
 /* TODO handle similar to error string */
-			memory_free(
+			libcerror_memory_free(
 			 *system_format_string );
 
 			*system_format_string = NULL;
@@ -300,30 +1061,53 @@ void libcerror_error_get_system_format_string(
 
 #endif /* defined( HAVE_STDARG_H ) || defined( WINAPI ) */
 
-/* Sets an error
+#if defined( va_copy )
+#define VACOPY( destination, source ) \
+        va_copy( destination, source )
+
+#elif defined( __va_copy )
+#define VACOPY( destination, source ) \
+        __va_copy( destination, source )
+
+#else
+#define VACOPY( destination, source ) \
+        ( destination ) = ( source )
+
+#endif /* defined( va_copy ) */
+
+/* Sets an error with an argument list
  * Creates the error if necessary
  * The error domain and code are set only the first time and the error message is appended for back tracing
+ * If there is insufficient memory to create the error, a preallocated reserve error is set
+ * with domain LIBCERROR_ERROR_DOMAIN_MEMORY and code LIBCERROR_MEMORY_ERROR_INSUFFICIENT
  */
-void VARARGS(
-      libcerror_error_set,
+void libcerror_error_vset(
       libcerror_error_t **error,
       int error_domain,
       int error_code,
-      const char *,
-      format_string )
+      const char *format_string,
+      va_list argument_list )
 {
-	va_list argument_list;
+	va_list argument_list_copy;
 
 	libcerror_internal_error_t *internal_error = NULL;
 	system_character_t *error_string           = NULL;
 	system_character_t *system_format_string   = NULL;
-	void *reallocation                         = NULL;
 	size_t error_string_size                   = 0;
 	size_t format_string_length                = 0;
+	size_t message_data_offset                 = 0;
 	size_t message_size                        = 0;
 	size_t next_message_size                   = LIBCERROR_MESSAGE_INCREMENT_SIZE;
+	int has_resize_error                       = 0;
 	int message_index                          = 0;
 	int print_count                            = 0;
+	int result                                 = 0;
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_format_scan_t format_scan;
+
+	size_t packed_size                         = 0;
+#endif
 
 	if( error == NULL )
 	{
@@ -333,6 +1117,11 @@ void VARARGS(
 	{
 		return;
 	}
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_increment(
+	 error_domain,
+	 error_code );
+#endif
 	format_string_length = narrow_string_length(
 	                        format_string );
 
@@ -356,61 +1145,229 @@ void VARARGS(
 		     error_domain,
 		     error_code ) != 1 )
 		{
-			goto on_error;
+			/* Fall back to the reserve error so that the caller is informed
+			 * that there is insufficient memory
+			 */
+			if( libcerror_error_initialize_reserve(
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
 		}
 	}
+	else if( ( (libcerror_internal_error_t *) *error )->number_of_messages == 0 )
+	{
+		/* An error that was reset takes the domain and code of the first message
+		 */
+		( (libcerror_internal_error_t *) *error )->domain = error_domain;
+		( (libcerror_internal_error_t *) *error )->code   = error_code;
+	}
 	internal_error = (libcerror_internal_error_t *) *error;
 
-	if( libcerror_error_resize(
-	     internal_error ) != 1 )
+	/* The messages of the reserve error are formatted without allocating memory
+	 */
+	if( internal_error->is_reserve != 0 )
 	{
-		goto on_error;
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
+
+		libcerror_error_append_reserve_message(
+		 internal_error,
+		 system_format_string,
+		 argument_list_copy );
+
+		va_end(
+		 argument_list_copy );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcerror_memory_free(
+		 system_format_string );
+#endif
+		libcerror_error_notify_set(
+		 *error,
+		 error_domain,
+		 error_code,
+		 0,
+		 0 );
+		return;
 	}
-	if( format_string_length > next_message_size )
+	message_index       = internal_error->number_of_messages;
+	message_data_offset = internal_error->message_data_size;
+
+	/* A format string without conversion specifiers does not need to be formatted
+	 * and in deferred formatting mode it is referenced instead of copied
+	 */
+	if( narrow_string_search_character(
+	     format_string,
+	     (int) '%',
+	     format_string_length ) == NULL )
 	{
-		next_message_size = ( ( format_string_length / LIBCERROR_MESSAGE_INCREMENT_SIZE ) + 1 )
-		                  * LIBCERROR_MESSAGE_INCREMENT_SIZE;
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcerror_error_append_message(
+		          &internal_error,
+		          system_format_string,
+		          system_string_length(
+		           system_format_string ),
+		          0 );
+#else
+		result = libcerror_error_append_message(
+		          &internal_error,
+		          system_format_string,
+		          format_string_length,
+		          ( libcerror_deferred_formatting != 0 ) ? LIBCERROR_MESSAGE_FLAG_STATIC : 0 );
+#endif
+		*error = (libcerror_error_t *) internal_error;
+
+		if( result != 1 )
+		{
+			has_resize_error = 1;
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcerror_memory_free(
+		 system_format_string );
+#endif
+		libcerror_error_notify_set(
+		 *error,
+		 error_domain,
+		 error_code,
+		 0,
+		 0 );
+		return;
 	}
-	do
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* In deferred formatting mode the format string and a packed copy of the arguments
+	 * are stored in the message data and the message is formatted when printed
+	 */
+	if( ( libcerror_deferred_formatting != 0 )
+	 && ( libcerror_format_scan(
+	       format_string,
+	       &format_scan ) == 1 )
+	 && ( format_scan.number_of_arguments >= 0 ) )
 	{
-		if( next_message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
+
+		result = libcerror_format_get_packed_size(
+		          &format_scan,
+		          argument_list_copy,
+		          &packed_size );
+
+		va_end(
+		 argument_list_copy );
+
+		if( result != 1 )
 		{
-			next_message_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+			goto on_error;
 		}
-		reallocation = memory_reallocate(
-		                error_string,
-		                sizeof( system_character_t ) * next_message_size );
-
-		if( reallocation == NULL )
+		if( libcerror_error_resize(
+		     &internal_error,
+		     message_index + 1,
+		     message_data_offset + packed_size ) != 1 )
 		{
-			memory_free(
-			 error_string );
+			has_resize_error = 1;
 
 			goto on_error;
 		}
-		error_string = (system_character_t *) reallocation;
+		*error = (libcerror_error_t *) internal_error;
 
-		message_size = next_message_size;
+		error_string = &( internal_error->message_data[ message_data_offset ] );
+
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
+
+		result = libcerror_format_pack(
+		          &format_scan,
+		          argument_list_copy,
+		          (uint8_t *) error_string,
+		          packed_size );
+
+		va_end(
+		 argument_list_copy );
+
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+		internal_error->messages[ message_index ] = error_string;
+		internal_error->sizes[ message_index ]    = packed_size;
+		internal_error->flags[ message_index ]    = LIBCERROR_MESSAGE_FLAG_DEFERRED;
+
+		internal_error->number_of_messages += 1;
+		internal_error->message_data_size  += packed_size;
+
+#if defined( HAVE_ERROR_STATISTICS )
+		libcerror_statistics_update_maximum_depth(
+		 internal_error->number_of_messages );
+#endif
+		libcerror_error_notify_set(
+		 *error,
+		 error_domain,
+		 error_code,
+		 0,
+		 0 );
+		return;
+	}
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( format_string_length > next_message_size )
+	{
+		next_message_size = ( ( format_string_length / LIBCERROR_MESSAGE_INCREMENT_SIZE ) + 1 )
+		                  * LIBCERROR_MESSAGE_INCREMENT_SIZE;
+	}
+	do
+	{
+		if( next_message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		{
+			next_message_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+		}
+		/* The message string is formatted directly into the message data of the error
+		 */
+		if( libcerror_error_resize(
+		     &internal_error,
+		     message_index + 1,
+		     message_data_offset + next_message_size ) != 1 )
+		{
+			has_resize_error = 1;
+
+			goto on_error;
+		}
+		*error = (libcerror_error_t *) internal_error;
+
+		error_string = &( internal_error->message_data[ message_data_offset ] );
+
+		/* Format into all the available message data, so that in most cases
+		 * a single pass suffices, and otherwise the message string size is known
+		 */
+		message_size = internal_error->allocated_message_data_size - message_data_offset;
+
+		if( message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		{
+			message_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+		}
 
 		/* argument_list cannot be reused in successive calls to vsnprintf
 		 */
-		VASTART(
-		 argument_list,
-		 const char *,
-		 format_string );
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
 
 		print_count = system_string_vsnprintf(
 		               error_string,
 		               message_size,
 		               system_format_string,
-		               argument_list );
+		               argument_list_copy );
 
-		VAEND(
-		 argument_list );
+		va_end(
+		 argument_list_copy );
 
 		if( print_count <= -1 )
 		{
-			next_message_size += LIBCERROR_MESSAGE_INCREMENT_SIZE;
+			next_message_size = message_size + LIBCERROR_MESSAGE_INCREMENT_SIZE;
 		}
 		else if( ( (size_t) print_count >= message_size )
 		      || ( error_string[ print_count ] != (system_character_t) 0 ) )
@@ -429,41 +1386,221 @@ void VARARGS(
 	}
 	while( print_count <= -1 );
 
-	if( message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+	/* Truncate the message string if it does not fit in LIBCERROR_MESSAGE_MAXIMUM_SIZE
+	 */
+	if( print_count <= -1 )
 	{
 		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 4 ] = (system_character_t) '.';
 		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 3 ] = (system_character_t) '.';
 		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 2 ] = (system_character_t) '.';
 		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 1 ] = 0;
 		error_string_size                                  = (size_t) LIBCERROR_MESSAGE_MAXIMUM_SIZE;
-	}
-	message_index = internal_error->number_of_messages - 1;
 
+#if defined( HAVE_ERROR_STATISTICS )
+		libcerror_statistics_increment_truncated_messages();
+#endif
+	}
 	internal_error->messages[ message_index ] = error_string;
 	internal_error->sizes[ message_index ]    = error_string_size;
+	internal_error->flags[ message_index ]    = 0;
+
+	internal_error->number_of_messages += 1;
+	internal_error->message_data_size  += error_string_size;
 
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_update_maximum_depth(
+	 internal_error->number_of_messages );
+#endif
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	memory_free(
+	libcerror_memory_free(
 	 system_format_string );
 
 	system_format_string = NULL;
 #endif
+	libcerror_error_notify_set(
+	 *error,
+	 error_domain,
+	 error_code,
+	 0,
+	 0 );
 	return;
 
 on_error:
+	/* If the error cannot be resized the message is formatted into the remaining message data
+	 * of the error, so that the message is truncated instead of lost
+	 */
+	if( has_resize_error != 0 )
+	{
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
+
+		result = libcerror_error_append_truncated_message(
+		          internal_error,
+		          system_format_string,
+		          argument_list_copy );
+
+		va_end(
+		 argument_list_copy );
+
+		if( result == 1 )
+		{
+#if defined( HAVE_ERROR_STATISTICS )
+			libcerror_statistics_increment_truncated_messages();
+#endif
+			libcerror_error_notify_set(
+			 *error,
+			 error_domain,
+			 error_code,
+			 0,
+			 0 );
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( system_format_string != NULL )
 	{
-		memory_free(
+		libcerror_memory_free(
 		 system_format_string );
 	}
 #endif
 	return;
 }
 
+/* Sets an error
+ * Creates the error if necessary
+ * The error domain and code are set only the first time and the error message is appended for back tracing
+ * If there is insufficient memory to create the error, a preallocated reserve error is set
+ * with domain LIBCERROR_ERROR_DOMAIN_MEMORY and code LIBCERROR_MEMORY_ERROR_INSUFFICIENT
+ */
+void VARARGS(
+      libcerror_error_set,
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      const char *,
+      format_string )
+{
+	va_list argument_list;
+
+	VASTART(
+	 argument_list,
+	 const char *,
+	 format_string );
+
+	libcerror_error_vset(
+	 error,
+	 error_domain,
+	 error_code,
+	 format_string,
+	 argument_list );
+
+	VAEND(
+	 argument_list );
+
+#if defined( HAVE_ERROR_REGISTRY )
+	if( error != NULL )
+	{
+		libcerror_registry_set_creation_site(
+		 *error,
+		 LIBCERROR_REGISTRY_RETURN_ADDRESS,
+		 NULL );
+	}
+#endif
+}
+
 #undef VARARGS
 #undef VASTART
 #undef VAEND
+#undef VACOPY
+
+/* Sets an error with a constant message string
+ * Creates the error if necessary
+ * The message string is not formatted and must remain valid for the lifetime of the error, e.g. a string literal,
+ * since it is referenced instead of copied
+ * The error domain and code are set only the first time and the error message is appended for back tracing
+ */
+void libcerror_error_set_static(
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      const char *message_string )
+{
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_internal_error_t *internal_error = NULL;
+#endif
+
+	if( error == NULL )
+	{
+		return;
+	}
+	if( message_string == NULL )
+	{
+		return;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* The message string needs to be converted into a system string
+	 */
+	libcerror_error_set(
+	 error,
+	 error_domain,
+	 error_code,
+	 "%s",
+	 message_string );
+#else
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_increment(
+	 error_domain,
+	 error_code );
+#endif
+	if( *error == NULL )
+	{
+		if( libcerror_error_initialize(
+		     error,
+		     error_domain,
+		     error_code ) != 1 )
+		{
+			if( libcerror_error_initialize_reserve(
+			     error ) != 1 )
+			{
+				return;
+			}
+		}
+	}
+	else if( ( (libcerror_internal_error_t *) *error )->number_of_messages == 0 )
+	{
+		/* An error that was reset takes the domain and code of the first message
+		 */
+		( (libcerror_internal_error_t *) *error )->domain = error_domain;
+		( (libcerror_internal_error_t *) *error )->code   = error_code;
+	}
+	internal_error = (libcerror_internal_error_t *) *error;
+
+	/* The error can be reallocated even if appending the message fails
+	 */
+	libcerror_error_append_message(
+	 &internal_error,
+	 message_string,
+	 narrow_string_length(
+	  message_string ),
+	 LIBCERROR_MESSAGE_FLAG_STATIC );
+
+	*error = (libcerror_error_t *) internal_error;
+
+	libcerror_error_notify_set(
+	 *error,
+	 error_domain,
+	 error_code,
+	 0,
+	 0 );
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_registry_set_creation_site(
+	 *error,
+	 LIBCERROR_REGISTRY_RETURN_ADDRESS,
+	 NULL );
+#endif
+}
 
 /* Determines if an error equals a certain error code of a domain
  * Returns 1 if error matches or 0 if not
@@ -485,73 +1622,1612 @@ int libcerror_error_matches(
 	return( 0 );
 }
 
-/* Prints a descriptive string of the error to the stream
- * Returns the number of printed characters if successful or -1 on error
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Formats a deferred message
+ * The message is truncated if it does not fit in the string
+ * Returns 1 if successful or -1 on error
  */
-int libcerror_error_fprint(
-     libcerror_error_t *error,
-     FILE *stream )
+int libcerror_error_format_deferred_message(
+     libcerror_internal_error_t *internal_error,
+     int message_index,
+     char *string,
+     size_t string_size,
+     size_t *message_size )
 {
-	libcerror_internal_error_t *internal_error = NULL;
-	system_character_t *error_string           = NULL;
-	int message_index                          = 0;
-	int print_count                            = 0;
+	int print_count = 0;
 
-#if defined( WINAPI ) || defined( __MINGW32__ )
-	const char *format_string                  = "%" PRIs_SYSTEM "\r\n";
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( ( internal_error->messages == NULL )
+	 || ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+	if( ( message_index < 0 )
+	 || ( message_index >= internal_error->number_of_messages ) )
+	{
+		return( -1 );
+	}
+	if( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) == 0 )
+	{
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( string_size < 4 )
+	{
+		return( -1 );
+	}
+	if( message_size == NULL )
+	{
+		return( -1 );
+	}
+	print_count = libcerror_format_print_packed(
+	               (uint8_t *) internal_error->messages[ message_index ],
+	               internal_error->sizes[ message_index ],
+	               string,
+	               string_size );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	if( (size_t) print_count >= string_size )
+	{
+		string[ string_size - 4 ] = '.';
+		string[ string_size - 3 ] = '.';
+		string[ string_size - 2 ] = '.';
+		string[ string_size - 1 ] = 0;
+
+		*message_size = string_size;
+	}
+	else
+	{
+		*message_size = (size_t) print_count + 1;
+	}
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Retrieves the size of the narrow string of a message
+ * The size includes the end-of-string character
+ * The size of a message string is stored in the error, except for deferred messages,
+ * which are formatted, and wide system character messages, which are converted
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_message_string_size(
+     libcerror_internal_error_t *internal_error,
+     int message_index,
+     size_t *string_size )
+{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	size_t print_count = 0;
 #else
-	const char *format_string                  = "%" PRIs_SYSTEM "\n";
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
 #endif
 
-	if( error == NULL )
+	if( internal_error == NULL )
 	{
 		return( -1 );
 	}
-	internal_error = (libcerror_internal_error_t *) error;
+	if( ( internal_error->messages == NULL )
+	 || ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+	if( ( message_index < 0 )
+	 || ( message_index >= internal_error->number_of_messages ) )
+	{
+		return( -1 );
+	}
+	if( internal_error->messages[ message_index ] == NULL )
+	{
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if defined( _MSC_VER )
+	if( wcstombs_s(
+	     &print_count,
+	     NULL,
+	     0,
+	     internal_error->messages[ message_index ],
+	     0 ) != 0 )
+	{
+		return( -1 );
+	}
+	*string_size = print_count;
+#else
+	print_count = wcstombs(
+	               NULL,
+	               internal_error->messages[ message_index ],
+	               0 );
+
+	if( print_count == (size_t) -1 )
+	{
+		return( -1 );
+	}
+	*string_size = print_count + 1;
+
+#endif /* defined( _MSC_VER ) */
+#else
+	if( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 )
+	{
+		if( libcerror_error_format_deferred_message(
+		     internal_error,
+		     message_index,
+		     message_string,
+		     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+		     string_size ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	else
+	{
+		*string_size = internal_error->sizes[ message_index ];
+	}
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( *string_size == 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the string required by libcerror_error_sprint
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_string_size(
+     libcerror_internal_error_t *internal_error,
+     size_t *size )
+{
+	size_t string_size = 0;
+	int message_index  = 0;
 
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
 	if( internal_error->messages == NULL )
 	{
 		return( -1 );
 	}
-	if( stream == NULL )
+	if( internal_error->number_of_messages <= 0 )
+	{
+		return( -1 );
+	}
+	if( size == NULL )
 	{
 		return( -1 );
 	}
 	message_index = internal_error->number_of_messages - 1;
-	error_string  = internal_error->messages[ message_index ];
 
-	if( error_string != NULL )
+	if( internal_error->messages[ message_index ] == NULL )
 	{
-		print_count = fprintf(
-		               stream,
-		               format_string,
-		               error_string );
+		*size = 0;
 
-		if( print_count <= -1 )
+		return( 1 );
+	}
+	if( libcerror_error_get_message_string_size(
+	     internal_error,
+	     message_index,
+	     &string_size ) != 1 )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	*size = string_size;
+#else
+	/* libcerror_error_sprint requires room for an additional character
+	 */
+	*size = string_size + 1;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size of the string required by libcerror_error_backtrace_sprint
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_backtrace_string_size(
+     libcerror_internal_error_t *internal_error,
+     size_t *size )
+{
+	size_t backtrace_string_size = 0;
+	size_t string_size           = 0;
+	int message_index            = 0;
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	size_t end_of_line_size      = 2;
+#else
+	size_t end_of_line_size      = 1;
+#endif
+
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->messages == NULL )
+	{
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		return( -1 );
+	}
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		if( internal_error->messages[ message_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcerror_error_get_message_string_size(
+		     internal_error,
+		     message_index,
+		     &string_size ) != 1 )
+		{
+			return( -1 );
+		}
+		if( backtrace_string_size > 0 )
+		{
+			backtrace_string_size += end_of_line_size;
+		}
+		backtrace_string_size += string_size - 1;
+	}
+	if( backtrace_string_size > 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		backtrace_string_size += 1;
+#else
+		/* libcerror_error_backtrace_sprint requires room for an additional character
+		 */
+		backtrace_string_size += 2;
+#endif
+	}
+	*size = backtrace_string_size;
+
+	return( 1 );
+}
+
+/* Prints a descriptive string of the error to the stream
+ * Returns the number of printed characters if successful or -1 on error
+ */
+int libcerror_error_fprint(
+     libcerror_error_t *error,
+     FILE *stream )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+	system_character_t *error_string           = NULL;
+	int message_index                          = 0;
+	int print_count                            = 0;
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	const char *format_string                  = "%" PRIs_SYSTEM "\r\n";
+#else
+	const char *format_string                  = "%" PRIs_SYSTEM "\n";
+#endif
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+	size_t message_string_size                 = 0;
+#endif
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( internal_error->messages == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->number_of_messages <= 0 )
+	{
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		return( -1 );
+	}
+	message_index = internal_error->number_of_messages - 1;
+	error_string  = internal_error->messages[ message_index ];
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( ( error_string != NULL )
+	 && ( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 ) )
+	{
+		if( libcerror_error_format_deferred_message(
+		     internal_error,
+		     message_index,
+		     message_string,
+		     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+		     &message_string_size ) != 1 )
+		{
+			return( -1 );
+		}
+		error_string = message_string;
+	}
+#endif
+	if( error_string != NULL )
+	{
+		print_count = fprintf(
+		               stream,
+		               format_string,
+		               error_string );
+
+		if( print_count <= -1 )
+		{
+			return( -1 );
+		}
+	}
+	return( print_count );
+}
+
+/* Prints a descriptive string of the error to the string
+ * The end-of-string character is not included in the return value
+ * If string is NULL and size is 0 the required size of the string is returned instead
+ * Returns the number of printed characters or the required size if successful or -1 on error
+ */
+int libcerror_error_sprint(
+     libcerror_error_t *error,
+     char *string,
+     size_t size )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+	system_character_t *error_string           = NULL;
+	size_t message_index                       = 0;
+	size_t print_count                         = 0;
+	size_t required_size                       = 0;
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+	size_t error_string_size                   = 0;
+#endif
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( internal_error->messages == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->sizes == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->number_of_messages <= 0 )
+	{
+		return( -1 );
+	}
+	if( ( string == NULL )
+	 && ( size == 0 ) )
+	{
+		if( libcerror_error_get_string_size(
+		     internal_error,
+		     &required_size ) != 1 )
+		{
+			return( -1 );
+		}
+		if( required_size > (size_t) INT_MAX )
+		{
+			return( -1 );
+		}
+		return( (int) required_size );
+	}
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+#if INT_MAX < SSIZE_MAX
+	if( size > (size_t) INT_MAX )
+#else
+	if( size > (size_t) SSIZE_MAX )
+#endif
+	{
+		return( -1 );
+	}
+	message_index = internal_error->number_of_messages - 1;
+	error_string  = internal_error->messages[ message_index ];
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	error_string_size = internal_error->sizes[ message_index ];
+
+	if( ( error_string != NULL )
+	 && ( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 ) )
+	{
+		if( libcerror_error_format_deferred_message(
+		     internal_error,
+		     (int) message_index,
+		     message_string,
+		     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+		     &error_string_size ) != 1 )
+		{
+			return( -1 );
+		}
+		error_string = message_string;
+	}
+#endif
+	if( error_string != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if defined( _MSC_VER )
+		if( wcstombs_s(
+		     &print_count,
+		     string,
+		     size,
+		     error_string,
+		     _TRUNCATE ) != 0 )
+		{
+			return( -1 );
+		}
+#else
+		print_count = wcstombs(
+		               string,
+		               error_string,
+		               size );
+
+		if( print_count == (size_t) -1 )
+		{
+			return( -1 );
+		}
+#endif /* defined( _MSC_VER ) */
+
+		if( print_count >= size )
+		{
+			return( -1 );
+		}
+#else
+		if( size < ( error_string_size + 1 ) )
+		{
+			return( -1 );
+		}
+		if( narrow_string_copy(
+		     string,
+		     error_string,
+		     error_string_size ) == NULL )
+		{
+			return( -1 );
+		}
+		print_count = error_string_size;
+
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+	}
+	if( print_count > (size_t) INT_MAX )
+	{
+		return( -1 );
+	}
+	return( (int) print_count );
+}
+
+/* Prints a backtrace of the error to the stream
+ * The stream is locked once for the entire backtrace, hence the backtrace is not interleaved
+ * with the output of other threads, and the messages are written with their stored sizes
+ * up to their first end-of-string character
+ * Returns the number of printed characters if successful or -1 on error
+ */
+int libcerror_error_backtrace_fprint(
+     libcerror_error_t *error,
+     FILE *stream )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+	system_character_t *error_string           = NULL;
+	int message_index                          = 0;
+	int total_print_count                      = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	const char *format_string                  = "%" PRIs_SYSTEM "\r\n";
+#else
+	const char *format_string                  = "%" PRIs_SYSTEM "\n";
+#endif
+	int print_count                            = 0;
+
+#else
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	static char end_of_line[ 2 ]               = { '\r', '\n' };
+	size_t end_of_line_size                    = 2;
+#else
+	static char end_of_line[ 1 ]               = { '\n' };
+	size_t end_of_line_size                    = 1;
+#endif
+	char *end_of_string                        = NULL;
+	size_t error_string_size                   = 0;
+	size_t write_count                         = 0;
+#endif
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( internal_error->messages == NULL )
+	{
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	flockfile(
+	 stream );
+#endif
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		error_string = internal_error->messages[ message_index ];
+
+		if( error_string != NULL )
+		{
+			print_count = fprintf(
+			               stream,
+			               format_string,
+			               error_string );
+
+			if( print_count <= -1 )
+			{
+				goto on_error;
+			}
+			total_print_count += print_count;
+		}
+	}
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	funlockfile(
+	 stream );
+#endif
+	return( total_print_count );
+#else
+	if( ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	flockfile(
+	 stream );
+#endif
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		error_string      = internal_error->messages[ message_index ];
+		error_string_size = internal_error->sizes[ message_index ];
+
+		if( error_string == NULL )
+		{
+			continue;
+		}
+		if( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 )
+		{
+			if( libcerror_error_format_deferred_message(
+			     internal_error,
+			     message_index,
+			     message_string,
+			     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+			     &error_string_size ) != 1 )
+			{
+				goto on_error;
+			}
+			error_string = message_string;
+		}
+		/* The stored size includes the end-of-string character
+		 */
+		if( error_string_size > 0 )
+		{
+			error_string_size -= 1;
+		}
+		/* Stop at an end-of-string character embedded in the message
+		 */
+		end_of_string = narrow_string_search_character(
+		                 error_string,
+		                 0,
+		                 error_string_size );
+
+		if( end_of_string != NULL )
+		{
+			error_string_size = (size_t) ( end_of_string - error_string );
+		}
+		if( error_string_size > ( (size_t) INT_MAX - end_of_line_size - (size_t) total_print_count ) )
+		{
+			goto on_error;
+		}
+		write_count = libcerror_error_fwrite(
+		               error_string,
+		               error_string_size,
+		               stream );
+
+		if( write_count != error_string_size )
+		{
+			goto on_error;
+		}
+		write_count = libcerror_error_fwrite(
+		               end_of_line,
+		               end_of_line_size,
+		               stream );
+
+		if( write_count != end_of_line_size )
+		{
+			goto on_error;
+		}
+		total_print_count += (int) ( error_string_size + end_of_line_size );
+	}
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	funlockfile(
+	 stream );
+#endif
+	return( total_print_count );
+
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+on_error:
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	funlockfile(
+	 stream );
+#endif
+	return( -1 );
+}
+
+/* Writes a backtrace of the error to the file descriptor
+ * The messages and their end-of-line characters are written with a single writev call,
+ * hence the backtrace is not interleaved with the output of other threads or processes
+ * if the file descriptor refers to a pipe, up to PIPE_BUF bytes, or a file opened for appending
+ * If writev is not available the backtrace is printed to a string that is written with a single write call
+ * Returns the number of written bytes if successful or -1 on error
+ */
+int libcerror_error_backtrace_write_fd(
+     libcerror_error_t *error,
+     int file_descriptor )
+{
+#if defined( HAVE_WRITEV ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	struct iovec stack_vectors[ LIBCERROR_BACKTRACE_NUMBER_OF_STACK_VECTORS ];
+
+	static char end_of_line[ 2 ]               = { '\n', 0 };
+
+	libcerror_internal_error_t *internal_error = NULL;
+	struct iovec *vectors                      = NULL;
+	char *deferred_message_data                = NULL;
+	char *error_string                         = NULL;
+	size_t deferred_message_data_offset        = 0;
+	size_t error_string_size                   = 0;
+	size_t total_write_count                   = 0;
+	ssize_t write_count                        = 0;
+	int maximum_number_of_vectors              = 0;
+	int message_index                          = 0;
+	int number_of_deferred_messages            = 0;
+	int number_of_vectors                      = 0;
+	int vector_index                           = 0;
+#else
+	libcerror_internal_error_t *internal_error = NULL;
+	char *backtrace_string                     = NULL;
+	size_t backtrace_string_size               = 0;
+	size_t write_offset                        = 0;
+	int print_count                            = 0;
+	int write_count                            = 0;
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	size_t end_of_line_size                    = 2;
+#else
+	size_t end_of_line_size                    = 1;
+#endif
+#endif /* defined( HAVE_WRITEV ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_WRITEV ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( ( internal_error->messages == NULL )
+	 || ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+	if( internal_error->number_of_messages > ( INT_MAX / 2 ) )
+	{
+		return( -1 );
+	}
+	vectors = stack_vectors;
+
+	if( ( 2 * internal_error->number_of_messages ) > LIBCERROR_BACKTRACE_NUMBER_OF_STACK_VECTORS )
+	{
+		vectors = (struct iovec *) libcerror_memory_allocate(
+		                            sizeof( struct iovec ) * 2 * internal_error->number_of_messages );
+
+		if( vectors == NULL )
+		{
+			return( -1 );
+		}
+	}
+	/* Deferred messages are formatted first since they are not stored as strings
+	 */
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		if( ( internal_error->messages[ message_index ] != NULL )
+		 && ( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 ) )
+		{
+			number_of_deferred_messages++;
+		}
+	}
+	if( number_of_deferred_messages > 0 )
+	{
+		deferred_message_data = (char *) libcerror_memory_allocate(
+		                                  sizeof( char ) * LIBCERROR_MESSAGE_MAXIMUM_SIZE * number_of_deferred_messages );
+
+		if( deferred_message_data == NULL )
+		{
+			goto on_error;
+		}
+	}
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		error_string      = internal_error->messages[ message_index ];
+		error_string_size = internal_error->sizes[ message_index ];
+
+		if( error_string == NULL )
+		{
+			continue;
+		}
+		if( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 )
+		{
+			error_string = &( deferred_message_data[ deferred_message_data_offset ] );
+
+			if( libcerror_error_format_deferred_message(
+			     internal_error,
+			     message_index,
+			     error_string,
+			     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+			     &error_string_size ) != 1 )
+			{
+				goto on_error;
+			}
+			deferred_message_data_offset += LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+		}
+		/* The message sizes include the end-of-string character
+		 */
+		if( error_string_size > 0 )
+		{
+			error_string_size -= 1;
+		}
+		vectors[ number_of_vectors ].iov_base = error_string;
+		vectors[ number_of_vectors ].iov_len  = error_string_size;
+
+		number_of_vectors++;
+
+		vectors[ number_of_vectors ].iov_base = end_of_line;
+		vectors[ number_of_vectors ].iov_len  = 1;
+
+		number_of_vectors++;
+
+		total_write_count += error_string_size + 1;
+	}
+	if( total_write_count > (size_t) INT_MAX )
+	{
+		goto on_error;
+	}
+#if defined( IOV_MAX )
+	maximum_number_of_vectors = IOV_MAX;
+#else
+	maximum_number_of_vectors = LIBCERROR_BACKTRACE_NUMBER_OF_STACK_VECTORS;
+#endif
+	/* Only a backtrace with more than IOV_MAX vectors or a partial write requires more than one call
+	 */
+	while( vector_index < number_of_vectors )
+	{
+		write_count = writev(
+		               file_descriptor,
+		               &( vectors[ vector_index ] ),
+		               ( ( number_of_vectors - vector_index ) < maximum_number_of_vectors ) ? number_of_vectors - vector_index : maximum_number_of_vectors );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			goto on_error;
+		}
+		while( ( vector_index < number_of_vectors )
+		    && ( (size_t) write_count >= vectors[ vector_index ].iov_len ) )
+		{
+			write_count -= (ssize_t) vectors[ vector_index ].iov_len;
+
+			vector_index++;
+		}
+		if( write_count > 0 )
+		{
+			vectors[ vector_index ].iov_base = &( ( (char *) vectors[ vector_index ].iov_base )[ write_count ] );
+			vectors[ vector_index ].iov_len -= (size_t) write_count;
+		}
+	}
+	if( deferred_message_data != NULL )
+	{
+		libcerror_memory_free(
+		 deferred_message_data );
+	}
+	if( vectors != stack_vectors )
+	{
+		libcerror_memory_free(
+		 vectors );
+	}
+	return( (int) total_write_count );
+
+on_error:
+	if( deferred_message_data != NULL )
+	{
+		libcerror_memory_free(
+		 deferred_message_data );
+	}
+	if( vectors != stack_vectors )
+	{
+		libcerror_memory_free(
+		 vectors );
+	}
+	return( -1 );
+#else
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( internal_error->number_of_messages == 0 )
+	{
+		return( 0 );
+	}
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               NULL,
+	               0 );
+
+	if( ( print_count <= 0 )
+	 || ( (size_t) print_count > ( (size_t) INT_MAX - end_of_line_size ) ) )
+	{
+		return( -1 );
+	}
+	/* Leave room to replace the end-of-string character by the end-of-line characters
+	 */
+	backtrace_string_size = (size_t) print_count + end_of_line_size - 1;
+
+	backtrace_string = (char *) libcerror_memory_allocate(
+	                             sizeof( char ) * ( backtrace_string_size + 1 ) );
+
+	if( backtrace_string == NULL )
+	{
+		return( -1 );
+	}
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               backtrace_string,
+	               (size_t) print_count );
+
+	if( print_count <= 0 )
+	{
+		goto on_error;
+	}
+	write_offset = (size_t) print_count - 1;
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	backtrace_string[ write_offset++ ] = '\r';
+#endif
+	backtrace_string[ write_offset++ ] = '\n';
+
+	backtrace_string_size = write_offset;
+	write_offset          = 0;
+
+	/* Only a partial write requires more than one call
+	 */
+	while( write_offset < backtrace_string_size )
+	{
+		write_count = (int) libcerror_error_write(
+		                     file_descriptor,
+		                     &( backtrace_string[ write_offset ] ),
+		                     backtrace_string_size - write_offset );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			goto on_error;
+		}
+		write_offset += (size_t) write_count;
+	}
+	libcerror_memory_free(
+	 backtrace_string );
+
+	return( (int) backtrace_string_size );
+
+on_error:
+	libcerror_memory_free(
+	 backtrace_string );
+
+	return( -1 );
+
+#endif /* defined( HAVE_WRITEV ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
+/* Prints a backtrace of the error to the string
+ * The end-of-string character is not included in the return value
+ * If string is NULL and size is 0 the required size of the string is returned instead
+ * The required size can be one more than the value returned when the backtrace is printed
+ * Returns the number of printed characters or the required size if successful or -1 on error
+ */
+int libcerror_error_backtrace_sprint(
+     libcerror_error_t *error,
+     char *string,
+     size_t size )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+	system_character_t *error_string           = NULL;
+	size_t required_size                       = 0;
+	size_t string_index                        = 0;
+	int message_index                          = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	size_t print_count                         = 0;
+#else
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+	size_t error_string_size                   = 0;
+#endif
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( internal_error->messages == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->sizes == NULL )
+	{
+		return( -1 );
+	}
+	if( ( string == NULL )
+	 && ( size == 0 ) )
+	{
+		if( libcerror_error_get_backtrace_string_size(
+		     internal_error,
+		     &required_size ) != 1 )
+		{
+			return( -1 );
+		}
+		if( required_size > (size_t) INT_MAX )
+		{
+			return( -1 );
+		}
+		return( (int) required_size );
+	}
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+#if INT_MAX < SSIZE_MAX
+	if( size > (size_t) INT_MAX )
+#else
+	if( size > (size_t) SSIZE_MAX )
+#endif
+	{
+		return( -1 );
+	}
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		error_string = internal_error->messages[ message_index ];
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		error_string_size = internal_error->sizes[ message_index ];
+
+		if( ( error_string != NULL )
+		 && ( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 ) )
+		{
+			if( libcerror_error_format_deferred_message(
+			     internal_error,
+			     message_index,
+			     message_string,
+			     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+			     &error_string_size ) != 1 )
+			{
+				return( -1 );
+			}
+			error_string = message_string;
+		}
+#endif
+		if( error_string != NULL )
+		{
+			if( string_index > 0 )
+			{
+#if defined( WINAPI ) || defined( __MINGW32__ )
+				if( ( string_index + 2 ) >= size )
+				{
+					return( -1 );
+				}
+				string[ string_index++ ] = (system_character_t) '\r';
+#else
+				if( ( string_index + 1 ) >= size )
+				{
+					return( -1 );
+				}
+#endif /* defined( WINAPI ) || defined( __MINGW32__ ) */
+
+				string[ string_index++ ] = (system_character_t) '\n';
+				string[ string_index ]   = (system_character_t) 0;
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if defined( _MSC_VER )
+			if( wcstombs_s(
+			     &print_count,
+			     &( string[ string_index ] ),
+			     size - string_index,
+			     error_string,
+			     _TRUNCATE ) != 0 )
+			{
+				return( -1 );
+			}
+#else
+			print_count = wcstombs(
+			               &( string[ string_index ] ),
+			               error_string,
+			               size - string_index );
+
+			if( print_count == (size_t) -1 )
+			{
+				return( -1 );
+			}
+#endif /*defined( _MSC_VER ) */
+
+			string_index += print_count;
+
+			if( string_index >= size )
+			{
+				return( -1 );
+			}
+			if( string[ string_index - 1 ] == 0 )
+			{
+				string_index--;
+			}
+#else
+			if( size < ( string_index + error_string_size + 1 ) )
+			{
+				return( -1 );
+			}
+			if( narrow_string_copy(
+			     &( string[ string_index ] ),
+			     error_string,
+			     error_string_size ) == NULL )
+			{
+				return( -1 );
+			}
+			string_index += error_string_size - 1;
+
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+		}
+	}
+	string_index++;
+
+	if( string_index > (size_t) INT_MAX )
+	{
+		return( -1 );
+	}
+	return( (int) string_index );
+}
+
+/* Prints a backtrace of the error to a string that is allocated to the required size
+ * The string size is set to the value returned by libcerror_error_backtrace_sprint
+ * The string is allocated with the libcerror memory functions and must be freed with libcerror_error_string_free
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_backtrace_sprint_allocated(
+     libcerror_error_t *error,
+     char **string,
+     size_t *string_size )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+	char *safe_string                          = NULL;
+	size_t safe_string_size                    = 0;
+	int print_count                            = 0;
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( *string != NULL )
+	{
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		return( -1 );
+	}
+	if( libcerror_error_get_backtrace_string_size(
+	     internal_error,
+	     &safe_string_size ) != 1 )
+	{
+		return( -1 );
+	}
+	/* An error without messages is printed as an empty string
+	 */
+	if( safe_string_size == 0 )
+	{
+		safe_string_size = 1;
+	}
+	if( safe_string_size > (size_t) INT_MAX )
+	{
+		return( -1 );
+	}
+	safe_string = (char *) libcerror_memory_allocate(
+	                        sizeof( char ) * safe_string_size );
+
+	if( safe_string == NULL )
+	{
+		return( -1 );
+	}
+	safe_string[ 0 ] = 0;
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               safe_string,
+	               safe_string_size );
+
+	if( print_count <= -1 )
+	{
+		libcerror_memory_free(
+		 safe_string );
+
+		return( -1 );
+	}
+	/* The required size can be larger than the size of the printed string
+	 */
+	*string      = safe_string;
+	*string_size = (size_t) print_count;
+
+	return( 1 );
+}
+
+/* Frees a string allocated by libcerror
+ */
+void libcerror_error_string_free(
+      char **string )
+{
+	if( string == NULL )
+	{
+		return;
+	}
+	if( *string != NULL )
+	{
+		libcerror_memory_free(
+		 *string );
+
+		*string = NULL;
+	}
+}
+
+/* Retrieves the number of frames of an error
+ * A frame is a message in the back trace, where frame 0 is the first message that was set
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_number_of_frames(
+     libcerror_error_t *error,
+     int *number_of_frames )
+{
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_frames == NULL )
+	{
+		return( -1 );
+	}
+	*number_of_frames = ( (libcerror_internal_error_t *) error )->number_of_messages;
+
+	return( 1 );
+}
+
+/* Retrieves the message of a specific frame
+ * The message references the storage of the error and is not copied, it remains valid
+ * until the error is modified, reset or freed
+ * The message size includes the end-of-string character
+ * Returns 1 if successful, 0 if the message is not available without formatting,
+ * such as a deferred message, or -1 on error
+ */
+int libcerror_error_get_frame_message(
+     libcerror_error_t *error,
+     int frame_index,
+     const char **message,
+     size_t *message_size )
+{
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_internal_error_t *internal_error = NULL;
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( ( internal_error->messages == NULL )
+	 || ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+	if( ( frame_index < 0 )
+	 || ( frame_index >= internal_error->number_of_messages ) )
+	{
+		return( -1 );
+	}
+	if( message == NULL )
+	{
+		return( -1 );
+	}
+	if( message_size == NULL )
+	{
+		return( -1 );
+	}
+	if( ( internal_error->messages[ frame_index ] == NULL )
+	 || ( ( internal_error->flags[ frame_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 ) )
+	{
+		return( 0 );
+	}
+	*message      = internal_error->messages[ frame_index ];
+	*message_size = internal_error->sizes[ frame_index ];
+
+	return( 1 );
+#else
+	return( -1 );
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
+/* Visits the frames of the error in order
+ * The callback is invoked for every frame with a message, with the frame index,
+ * the message and the message size including the end-of-string character
+ * Stored messages are passed without copying, deferred messages are formatted on the stack,
+ * hence the message is only valid for the duration of the callback
+ * The callback returns 1 to continue, 0 to stop or -1 on error and must not modify or free the error
+ * Returns 1 if all frames were visited, 0 if the callback stopped the visit or -1 on error
+ */
+int libcerror_error_backtrace_visit(
+     libcerror_error_t *error,
+     int (*callback)(
+            int frame_index,
+            const char *message,
+            size_t message_size,
+            void *context ),
+     void *context )
+{
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+	libcerror_internal_error_t *internal_error = NULL;
+	char *error_string                         = NULL;
+	size_t error_string_size                   = 0;
+	int message_index                          = 0;
+	int result                                 = 0;
+
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( ( internal_error->messages == NULL )
+	 || ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		return( -1 );
+	}
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		error_string      = internal_error->messages[ message_index ];
+		error_string_size = internal_error->sizes[ message_index ];
+
+		if( error_string == NULL )
+		{
+			continue;
+		}
+		if( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 )
+		{
+			if( libcerror_error_format_deferred_message(
+			     internal_error,
+			     message_index,
+			     message_string,
+			     LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+			     &error_string_size ) != 1 )
+			{
+				return( -1 );
+			}
+			error_string = message_string;
+		}
+		result = callback(
+		          message_index,
+		          error_string,
+		          error_string_size,
+		          context );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	return( 1 );
+#else
+	return( -1 );
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Retrieves the narrow string of a message
+ * A deferred message is formatted into the message string buffer, other messages are not copied
+ * Returns 1 if successful, 0 if the message is not set or -1 on error
+ */
+int libcerror_error_get_message_string(
+     libcerror_internal_error_t *internal_error,
+     int message_index,
+     char *message_string,
+     size_t message_string_size,
+     const char **string,
+     size_t *string_length )
+{
+	size_t safe_string_size = 0;
+
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( ( internal_error->messages == NULL )
+	 || ( internal_error->sizes == NULL )
+	 || ( internal_error->flags == NULL ) )
+	{
+		return( -1 );
+	}
+	if( ( message_index < 0 )
+	 || ( message_index >= internal_error->number_of_messages ) )
+	{
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( string_length == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_error->messages[ message_index ] == NULL )
+	{
+		return( 0 );
+	}
+	if( ( internal_error->flags[ message_index ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) != 0 )
+	{
+		if( libcerror_error_format_deferred_message(
+		     internal_error,
+		     message_index,
+		     message_string,
+		     message_string_size,
+		     &safe_string_size ) != 1 )
+		{
+			return( -1 );
+		}
+		*string = message_string;
+	}
+	else
+	{
+		safe_string_size = internal_error->sizes[ message_index ];
+
+		*string = internal_error->messages[ message_index ];
+	}
+	/* The size includes the end-of-string character
+	 */
+	if( safe_string_size > 0 )
+	{
+		safe_string_size -= 1;
+	}
+	*string_length = safe_string_size;
+
+	return( 1 );
+}
+
+/* Prints the header of a JSON backtrace of the error, up to and including the start of the frames array
+ * Returns the number of printed characters if successful or -1 on error
+ */
+int libcerror_error_print_backtrace_json_header(
+     libcerror_internal_error_t *internal_error,
+     char *string,
+     size_t string_size )
+{
+	int print_count = 0;
+
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( string_size < LIBCERROR_JSON_HEADER_SIZE )
+	{
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               string,
+	               string_size,
+	               "{\"domain\":%d,\"code\":%d,\"domain_name\":\"%s\",\"frames\":[",
+	               internal_error->domain,
+	               internal_error->code,
+	               libcerror_statistics_get_domain_name(
+	                internal_error->domain ) );
+
+	if( ( print_count <= -1 )
+	 || ( (size_t) print_count >= string_size ) )
+	{
+		return( -1 );
+	}
+	return( print_count );
+}
+
+/* Retrieves the length of the JSON backtrace of the error
+ * The length does not include the end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_error_get_backtrace_json_string_length(
+     libcerror_internal_error_t *internal_error,
+     size_t *string_length )
+{
+	char header_string[ LIBCERROR_JSON_HEADER_SIZE ];
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+	const char *error_string     = NULL;
+	size_t error_string_length   = 0;
+	size_t escaped_string_length = 0;
+	size_t safe_string_length    = 0;
+	int message_index            = 0;
+	int number_of_frames         = 0;
+	int print_count              = 0;
+	int result                   = 0;
+
+	if( internal_error == NULL )
+	{
+		return( -1 );
+	}
+	if( string_length == NULL )
+	{
+		return( -1 );
+	}
+	print_count = libcerror_error_print_backtrace_json_header(
+	               internal_error,
+	               header_string,
+	               LIBCERROR_JSON_HEADER_SIZE );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	safe_string_length = (size_t) print_count;
+
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		result = libcerror_error_get_message_string(
+		          internal_error,
+		          message_index,
+		          message_string,
+		          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+		          &error_string,
+		          &error_string_length );
+
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( libcerror_json_get_escaped_string_length(
+		     (uint8_t *) error_string,
+		     error_string_length,
+		     &escaped_string_length ) != 1 )
 		{
 			return( -1 );
 		}
+		/* The escaped message is enclosed in quotation marks and preceded by a comma
+		 * for every frame but the first
+		 */
+		if( number_of_frames > 0 )
+		{
+			safe_string_length += 1;
+		}
+		safe_string_length += escaped_string_length + 2;
+
+		number_of_frames++;
 	}
-	return( print_count );
+	/* The end of the frames array and the object
+	 */
+	*string_length = safe_string_length + 2;
+
+	return( 1 );
 }
 
-/* Prints a descriptive string of the error to the string
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Prints a backtrace of the error as a JSON object to the string
+ * The object contains the domain, code and domain name of the error and an array of the
+ * messages of its frames, where bytes that are not valid UTF-8 are replaced by \ufffd
  * The end-of-string character is not included in the return value
- * Returns the number of printed characters if successful or -1 on error
+ * If string is NULL and size is 0 the required size of the string is returned instead
+ * Returns the number of printed characters or the required size if successful or -1 on error
  */
-int libcerror_error_sprint(
+int libcerror_error_backtrace_json_sprint(
      libcerror_error_t *error,
      char *string,
      size_t size )
 {
-	libcerror_internal_error_t *internal_error = NULL;
-	system_character_t *error_string           = NULL;
-	size_t message_index                       = 0;
-	size_t print_count                         = 0;
-
 #if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	size_t error_string_size                   = 0;
-#endif
+	char header_string[ LIBCERROR_JSON_HEADER_SIZE ];
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
+	libcerror_internal_error_t *internal_error = NULL;
+	const char *error_string                   = NULL;
+	size_t error_string_index                  = 0;
+	size_t error_string_length                 = 0;
+	size_t string_index                        = 0;
+	size_t string_length                       = 0;
+	int message_index                          = 0;
+	int number_of_frames                       = 0;
+	int print_count                            = 0;
+	int result                                 = 0;
 
 	if( error == NULL )
 	{
@@ -559,15 +3235,26 @@ int libcerror_error_sprint(
 	}
 	internal_error = (libcerror_internal_error_t *) error;
 
-	if( internal_error->messages == NULL )
+	if( ( string == NULL )
+	 && ( size == 0 ) )
 	{
-		return( -1 );
+		if( libcerror_error_get_backtrace_json_string_length(
+		     internal_error,
+		     &string_length ) != 1 )
+		{
+			return( -1 );
+		}
+		if( string_length >= (size_t) INT_MAX )
+		{
+			return( -1 );
+		}
+		return( (int) string_length + 1 );
 	}
-	if( internal_error->sizes == NULL )
+	if( string == NULL )
 	{
 		return( -1 );
 	}
-	if( string == NULL )
+	if( size == 0 )
 	{
 		return( -1 );
 	}
@@ -579,81 +3266,121 @@ int libcerror_error_sprint(
 	{
 		return( -1 );
 	}
-	message_index = internal_error->number_of_messages - 1;
-	error_string  = internal_error->messages[ message_index ];
+	print_count = libcerror_error_print_backtrace_json_header(
+	               internal_error,
+	               header_string,
+	               LIBCERROR_JSON_HEADER_SIZE );
 
-	if( error_string != NULL )
+	if( print_count <= -1 )
 	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-#if defined( _MSC_VER )
-		if( wcstombs_s(
-		     &print_count,
-		     string,
-		     size,
-		     error_string,
-		     _TRUNCATE ) != 0 )
+		return( -1 );
+	}
+	/* Reserve space for the end-of-string character
+	 */
+	size -= 1;
+
+	if( (size_t) print_count > size )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     string,
+	     header_string,
+	     (size_t) print_count ) == NULL )
+	{
+		return( -1 );
+	}
+	string_index = (size_t) print_count;
+
+	for( message_index = 0;
+	     message_index < internal_error->number_of_messages;
+	     message_index++ )
+	{
+		result = libcerror_error_get_message_string(
+		          internal_error,
+		          message_index,
+		          message_string,
+		          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+		          &error_string,
+		          &error_string_length );
+
+		if( result == -1 )
 		{
 			return( -1 );
 		}
-#else
-		print_count = wcstombs(
-		               string,
-		               error_string,
-		               size );
-
-		if( print_count == (size_t) -1 )
+		else if( result == 0 )
 		{
-			return( -1 );
+			continue;
 		}
-#endif /* defined( _MSC_VER ) */
-
-		if( print_count >= size )
+		if( ( size - string_index ) < 2 )
 		{
 			return( -1 );
 		}
-#else
-		error_string_size = internal_error->sizes[ message_index ];
+		if( number_of_frames > 0 )
+		{
+			string[ string_index++ ] = ',';
+		}
+		string[ string_index++ ] = '"';
 
-		if( size < ( error_string_size + 1 ) )
+		error_string_index = 0;
+
+		if( libcerror_json_escape_string(
+		     (uint8_t *) error_string,
+		     error_string_length,
+		     &error_string_index,
+		     string,
+		     size,
+		     &string_index ) != 1 )
 		{
 			return( -1 );
 		}
-		if( narrow_string_copy(
-		     string,
-		     error_string,
-		     error_string_size ) == NULL )
+		if( ( size - string_index ) < 1 )
 		{
 			return( -1 );
 		}
-		print_count = error_string_size;
+		string[ string_index++ ] = '"';
 
-#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+		number_of_frames++;
 	}
-	if( print_count > (size_t) INT_MAX )
+	if( ( size - string_index ) < 2 )
 	{
 		return( -1 );
 	}
-	return( (int) print_count );
+	string[ string_index++ ] = ']';
+	string[ string_index++ ] = '}';
+	string[ string_index ]   = 0;
+
+	return( (int) string_index );
+#else
+	return( -1 );
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
 }
 
-/* Prints a backtrace of the error to the stream
+/* Prints a backtrace of the error as a JSON object to the stream
+ * The object is followed by an end-of-line character, hence successive backtraces form
+ * newline delimited JSON (NDJSON), and the stream is locked once for the entire backtrace
  * Returns the number of printed characters if successful or -1 on error
  */
-int libcerror_error_backtrace_fprint(
+int libcerror_error_backtrace_json_fprint(
      libcerror_error_t *error,
      FILE *stream )
 {
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	char escaped_string[ LIBCERROR_JSON_STREAM_BUFFER_SIZE ];
+	char header_string[ LIBCERROR_JSON_HEADER_SIZE ];
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+
 	libcerror_internal_error_t *internal_error = NULL;
-	system_character_t *error_string           = NULL;
+	const char *error_string                   = NULL;
+	size_t error_string_index                  = 0;
+	size_t error_string_length                 = 0;
+	size_t escaped_string_index                = 0;
+	size_t total_write_count                   = 0;
 	int message_index                          = 0;
+	int number_of_frames                       = 0;
 	int print_count                            = 0;
-	int total_print_count                      = 0;
-
-#if defined( WINAPI ) || defined( __MINGW32__ )
-	const char *format_string                  = "%" PRIs_SYSTEM "\r\n";
-#else
-	const char *format_string                  = "%" PRIs_SYSTEM "\n";
-#endif
+	int result                                 = 0;
 
 	if( error == NULL )
 	{
@@ -661,167 +3388,123 @@ int libcerror_error_backtrace_fprint(
 	}
 	internal_error = (libcerror_internal_error_t *) error;
 
-	if( internal_error->messages == NULL )
-	{
-		return( -1 );
-	}
 	if( stream == NULL )
 	{
 		return( -1 );
 	}
-	for( message_index = 0;
-	     message_index < internal_error->number_of_messages;
-	     message_index++ )
-	{
-		error_string = internal_error->messages[ message_index ];
-
-		if( error_string != NULL )
-		{
-			print_count = fprintf(
-			               stream,
-			               format_string,
-			               error_string );
-
-			if( print_count <= -1 )
-			{
-				return( -1 );
-			}
-			total_print_count += print_count;
-		}
-	}
-	return( total_print_count );
-}
-
-/* Prints a backtrace of the error to the string
- * The end-of-string character is not included in the return value
- * Returns the number of printed characters if successful or -1 on error
- */
-int libcerror_error_backtrace_sprint(
-     libcerror_error_t *error,
-     char *string,
-     size_t size )
-{
-	libcerror_internal_error_t *internal_error = NULL;
-	system_character_t *error_string           = NULL;
-	size_t string_index                        = 0;
-	int message_index                          = 0;
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	size_t print_count                         = 0;
-#else
-	size_t error_string_size                   = 0;
-#endif
-
-	if( error == NULL )
-	{
-		return( -1 );
-	}
-	internal_error = (libcerror_internal_error_t *) error;
+	print_count = libcerror_error_print_backtrace_json_header(
+	               internal_error,
+	               header_string,
+	               LIBCERROR_JSON_HEADER_SIZE );
 
-	if( internal_error->messages == NULL )
-	{
-		return( -1 );
-	}
-	if( internal_error->sizes == NULL )
-	{
-		return( -1 );
-	}
-	if( string == NULL )
+	if( print_count <= -1 )
 	{
 		return( -1 );
 	}
-#if INT_MAX < SSIZE_MAX
-	if( size > (size_t) INT_MAX )
-#else
-	if( size > (size_t) SSIZE_MAX )
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	flockfile(
+	 stream );
 #endif
+	if( libcerror_error_fwrite(
+	     header_string,
+	     (size_t) print_count,
+	     stream ) != (size_t) print_count )
 	{
-		return( -1 );
+		goto on_error;
 	}
+	total_write_count = (size_t) print_count;
+
 	for( message_index = 0;
 	     message_index < internal_error->number_of_messages;
 	     message_index++ )
 	{
-		error_string = internal_error->messages[ message_index ];
-
-		if( error_string != NULL )
+		result = libcerror_error_get_message_string(
+		          internal_error,
+		          message_index,
+		          message_string,
+		          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+		          &error_string,
+		          &error_string_length );
+
+		if( result == -1 )
 		{
-			if( string_index > 0 )
-			{
-#if defined( WINAPI ) || defined( __MINGW32__ )
-				if( ( string_index + 2 ) >= size )
-				{
-					return( -1 );
-				}
-				string[ string_index++ ] = (system_character_t) '\r';
-#else
-				if( ( string_index + 1 ) >= size )
-				{
-					return( -1 );
-				}
-#endif /* defined( WINAPI ) || defined( __MINGW32__ ) */
-
-				string[ string_index++ ] = (system_character_t) '\n';
-				string[ string_index ]   = (system_character_t) 0;
-			}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-#if defined( _MSC_VER )
-			if( wcstombs_s(
-			     &print_count,
-			     &( string[ string_index ] ),
-			     size - string_index,
-			     error_string,
-			     _TRUNCATE ) != 0 )
-			{
-				return( -1 );
-			}
-#else
-			print_count = wcstombs(
-			               &( string[ string_index ] ),
-			               error_string,
-			               size - string_index );
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		escaped_string_index = 0;
 
-			if( print_count == (size_t) -1 )
-			{
-				return( -1 );
-			}
-#endif /*defined( _MSC_VER ) */
+		if( number_of_frames > 0 )
+		{
+			escaped_string[ escaped_string_index++ ] = ',';
+		}
+		escaped_string[ escaped_string_index++ ] = '"';
 
-			string_index += print_count;
+		error_string_index = 0;
 
-			if( string_index >= size )
-			{
-				return( -1 );
-			}
-			if( string[ string_index - 1 ] == 0 )
+		/* The message is escaped in parts that fit in the escaped string buffer
+		 */
+		do
+		{
+			result = libcerror_json_escape_string(
+			          (uint8_t *) error_string,
+			          error_string_length,
+			          &error_string_index,
+			          escaped_string,
+			          LIBCERROR_JSON_STREAM_BUFFER_SIZE - 1,
+			          &escaped_string_index );
+
+			if( result == -1 )
 			{
-				string_index--;
+				goto on_error;
 			}
-#else
-			error_string_size = internal_error->sizes[ message_index ];
-
-			if( size < ( string_index + error_string_size + 1 ) )
+			else if( result == 1 )
 			{
-				return( -1 );
+				escaped_string[ escaped_string_index++ ] = '"';
 			}
-			if( narrow_string_copy(
-			     &( string[ string_index ] ),
-			     error_string,
-			     error_string_size ) == NULL )
+			if( libcerror_error_fwrite(
+			     escaped_string,
+			     escaped_string_index,
+			     stream ) != escaped_string_index )
 			{
-				return( -1 );
+				goto on_error;
 			}
-			string_index += error_string_size - 1;
-
-#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+			total_write_count   += escaped_string_index;
+			escaped_string_index = 0;
 		}
+		while( result == 0 );
+
+		number_of_frames++;
 	}
-	string_index++;
+	if( libcerror_error_fwrite(
+	     "]}\n",
+	     3,
+	     stream ) != 3 )
+	{
+		goto on_error;
+	}
+	total_write_count += 3;
 
-	if( string_index > (size_t) INT_MAX )
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	funlockfile(
+	 stream );
+#endif
+	if( total_write_count > (size_t) INT_MAX )
 	{
 		return( -1 );
 	}
-	return( (int) string_index );
-}
+	return( (int) total_write_count );
+
+on_error:
+#if defined( HAVE_FLOCKFILE ) && defined( HAVE_FUNLOCKFILE )
+	funlockfile(
+	 stream );
+#endif
+	return( -1 );
+#else
+	return( -1 );
 
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
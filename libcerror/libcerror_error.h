@@ -27,6 +27,14 @@
 
 #include <stdio.h>
 
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
 #include "libcerror_extern.h"
 #include "libcerror_types.h"
 
@@ -36,6 +44,10 @@ extern "C" {
 
 typedef struct libcerror_internal_error libcerror_internal_error_t;
 
+/* The error is stored in a single contiguous block of memory (arena):
+ * [ error ][ messages ][ sizes ][ flags ][ message data ]
+ * where messages, sizes and flags form the message (frame) index
+ */
 struct libcerror_internal_error
 {
 	/* The error domain
@@ -50,28 +62,130 @@ struct libcerror_internal_error
 	 */
 	int number_of_messages;
 
+	/* The number of allocated messages
+	 */
+	int number_of_allocated_messages;
+
 	/* A dynamic array containing the message strings
 	 */
 	system_character_t **messages;
 
 	/* A dynamic array containing the message string sizes
-	 * without the end-of-string character
+	 * including the end-of-string character
 	 */
 	size_t *sizes;
+
+	/* A dynamic array containing the message flags
+	 */
+	uint32_t *flags;
+
+	/* The message data
+	 */
+	system_character_t *message_data;
+
+	/* The message data size
+	 */
+	size_t message_data_size;
+
+	/* The allocated message data size
+	 */
+	size_t allocated_message_data_size;
+
+	/* Value to indicate the error is the reserve error
+	 */
+	int is_reserve;
+
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	/* The creation time of the error in nanoseconds of the monotonic clock
+	 */
+	uint64_t creation_time;
+#endif
+
+#if defined( HAVE_ERROR_REGISTRY )
+	/* The previous and next error in the live error registry
+	 */
+	libcerror_internal_error_t *previous_live_error;
+	libcerror_internal_error_t *next_live_error;
+
+	/* Value to indicate the error is in the live error registry
+	 */
+	int is_live;
+
+	/* The address of the code that created the error
+	 */
+	const void *creation_address;
+
+	/* The call site that created the error
+	 */
+	libcerror_callsite_t *creation_callsite;
+#endif
 };
 
+int libcerror_error_get_arena_size(
+     int number_of_messages,
+     size_t message_data_size,
+     size_t *arena_size );
+
+void libcerror_error_set_arena_layout(
+      libcerror_internal_error_t *internal_error );
+
 int libcerror_error_initialize(
      libcerror_error_t **error,
      int error_domain,
      int error_code );
 
+int libcerror_error_initialize_reserve(
+     libcerror_error_t **error );
+
 LIBCERROR_EXTERN \
 void libcerror_error_free(
       libcerror_error_t **error );
 
-int libcerror_error_resize(
+LIBCERROR_EXTERN \
+int libcerror_error_reset(
+     libcerror_error_t *error );
+
+LIBCERROR_EXTERN \
+int libcerror_error_get_depth(
+     libcerror_error_t *error,
+     int *depth );
+
+LIBCERROR_EXTERN \
+int libcerror_error_truncate(
+     libcerror_error_t *error,
+     int depth );
+
+int libcerror_error_is_reserve(
      libcerror_internal_error_t *internal_error );
 
+int libcerror_error_resize(
+     libcerror_internal_error_t **internal_error,
+     int number_of_messages,
+     size_t message_data_size );
+
+int libcerror_error_append_message(
+     libcerror_internal_error_t **internal_error,
+     const system_character_t *message_string,
+     size_t message_string_length,
+     uint32_t message_flags );
+
+int libcerror_error_append_reserve_message(
+     libcerror_internal_error_t *internal_error,
+     const system_character_t *format_string,
+     va_list argument_list );
+
+int libcerror_error_append_truncated_message(
+     libcerror_internal_error_t *internal_error,
+     const system_character_t *format_string,
+     va_list argument_list );
+
+void libcerror_error_notify_set(
+      libcerror_error_t *error,
+      int error_domain,
+      int error_code,
+      int is_system_error,
+      uint32_t system_error_code );
+
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 
 void libcerror_error_get_system_format_string(
@@ -81,6 +195,14 @@ void libcerror_error_get_system_format_string(
 
 #endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
 
+LIBCERROR_EXTERN \
+void libcerror_error_vset(
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      const char *format_string,
+      va_list argument_list );
+
 LIBCERROR_EXTERN \
 void libcerror_error_set(
       libcerror_error_t **error,
@@ -89,12 +211,73 @@ void libcerror_error_set(
       const char *format_string,
       ... );
 
+LIBCERROR_EXTERN \
+void libcerror_error_set_static(
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      const char *message_string );
+
+#if defined( HAVE_LOCAL_LIBCERROR )
+
+/* The string literal concatenation ensures the message string is a string literal
+ */
+#define LIBCERROR_ERROR_SET_STATIC( error, error_domain, error_code, message_string ) \
+	libcerror_error_set_static( error, error_domain, error_code, "" message_string )
+
+#endif /* defined( HAVE_LOCAL_LIBCERROR ) */
+
 LIBCERROR_EXTERN \
 int libcerror_error_matches(
      libcerror_error_t *error,
      int error_domain,
      int error_code );
 
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+int libcerror_error_format_deferred_message(
+     libcerror_internal_error_t *internal_error,
+     int message_index,
+     char *string,
+     size_t string_size,
+     size_t *message_size );
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+int libcerror_error_get_message_string_size(
+     libcerror_internal_error_t *internal_error,
+     int message_index,
+     size_t *string_size );
+
+int libcerror_error_get_string_size(
+     libcerror_internal_error_t *internal_error,
+     size_t *size );
+
+int libcerror_error_get_backtrace_string_size(
+     libcerror_internal_error_t *internal_error,
+     size_t *size );
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+int libcerror_error_get_message_string(
+     libcerror_internal_error_t *internal_error,
+     int message_index,
+     char *message_string,
+     size_t message_string_size,
+     const char **string,
+     size_t *string_length );
+
+int libcerror_error_print_backtrace_json_header(
+     libcerror_internal_error_t *internal_error,
+     char *string,
+     size_t string_size );
+
+int libcerror_error_get_backtrace_json_string_length(
+     libcerror_internal_error_t *internal_error,
+     size_t *string_length );
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
 LIBCERROR_EXTERN \
 int libcerror_error_fprint(
      libcerror_error_t *error,
@@ -111,12 +294,60 @@ int libcerror_error_backtrace_fprint(
      libcerror_error_t *error,
      FILE *stream );
 
+LIBCERROR_EXTERN \
+int libcerror_error_backtrace_write_fd(
+     libcerror_error_t *error,
+     int file_descriptor );
+
 LIBCERROR_EXTERN \
 int libcerror_error_backtrace_sprint(
      libcerror_error_t *error,
      char *string,
      size_t size );
 
+LIBCERROR_EXTERN \
+int libcerror_error_backtrace_sprint_allocated(
+     libcerror_error_t *error,
+     char **string,
+     size_t *string_size );
+
+LIBCERROR_EXTERN \
+void libcerror_error_string_free(
+      char **string );
+
+LIBCERROR_EXTERN \
+int libcerror_error_get_number_of_frames(
+     libcerror_error_t *error,
+     int *number_of_frames );
+
+LIBCERROR_EXTERN \
+int libcerror_error_get_frame_message(
+     libcerror_error_t *error,
+     int frame_index,
+     const char **message,
+     size_t *message_size );
+
+LIBCERROR_EXTERN \
+int libcerror_error_backtrace_visit(
+     libcerror_error_t *error,
+     int (*callback)(
+            int frame_index,
+            const char *message,
+            size_t message_size,
+            void *context ),
+     void *context );
+
+LIBCERROR_EXTERN \
+int libcerror_error_backtrace_json_sprint(
+     libcerror_error_t *error,
+     char *string,
+     size_t size );
+
+LIBCERROR_EXTERN \
+int libcerror_error_backtrace_json_fprint(
+     libcerror_error_t *error,
+     FILE *stream );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1094 @@
+/*
+ * Format string functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
+#include "libcerror_definitions.h"
+#include "libcerror_format.h"
+
+/* _snprintf_s with _TRUNCATE returns -1 instead of the required size when
+ * the output is truncated, which is handled by libcerror_format_print_packed
+ */
+#if defined( _MSC_VER )
+#define libcerror_format_snprintf( string, size, ... ) \
+	_snprintf_s( string, size, _TRUNCATE, __VA_ARGS__ )
+#else
+#define libcerror_format_snprintf( string, size, ... ) \
+	narrow_string_snprintf( string, size, __VA_ARGS__ )
+#endif
+
+#if defined( LIBCERROR_THREAD_LOCAL )
+
+/* The scan cache, indexed by the format string pointer
+ * The cache is thread-local hence it does not need to be locked
+ */
+static LIBCERROR_THREAD_LOCAL libcerror_format_scan_t libcerror_format_scan_cache[ LIBCERROR_FORMAT_SCAN_CACHE_SIZE ];
+
+#endif /* defined( LIBCERROR_THREAD_LOCAL ) */
+
+/* Parses a conversion specification
+ * The string index should point to the '%' character of the conversion specification
+ * and will point to the character after the conversion specification on return
+ * The argument types consumed by the conversion specification are stored in order,
+ * where a '*' width or precision consumes an int argument before the value
+ * Returns 1 if successful, 0 if the conversion specification is not supported or -1 on error
+ */
+int libcerror_format_parse_specification(
+     const char *format_string,
+     size_t *string_index,
+     uint8_t *argument_types,
+     int *number_of_argument_types )
+{
+	size_t safe_string_index = 0;
+	uint8_t argument_type    = 0;
+	char conversion          = 0;
+	char length_modifier     = 0;
+	int argument_type_index  = 0;
+	int has_precision        = 0;
+
+	if( format_string == NULL )
+	{
+		return( -1 );
+	}
+	if( string_index == NULL )
+	{
+		return( -1 );
+	}
+	if( argument_types == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_argument_types == NULL )
+	{
+		return( -1 );
+	}
+	safe_string_index = *string_index;
+
+	if( format_string[ safe_string_index ] != '%' )
+	{
+		return( -1 );
+	}
+	safe_string_index++;
+
+	if( format_string[ safe_string_index ] == '%' )
+	{
+		*string_index             = safe_string_index + 1;
+		*number_of_argument_types = 0;
+
+		return( 1 );
+	}
+	/* Flags
+	 */
+	while( ( format_string[ safe_string_index ] == '-' )
+	    || ( format_string[ safe_string_index ] == '+' )
+	    || ( format_string[ safe_string_index ] == ' ' )
+	    || ( format_string[ safe_string_index ] == '#' )
+	    || ( format_string[ safe_string_index ] == '0' ) )
+	{
+		safe_string_index++;
+	}
+	/* Width
+	 */
+	if( format_string[ safe_string_index ] == '*' )
+	{
+		argument_types[ argument_type_index++ ] = LIBCERROR_FORMAT_ARGUMENT_TYPE_INT;
+
+		safe_string_index++;
+	}
+	else
+	{
+		while( ( format_string[ safe_string_index ] >= '0' )
+		    && ( format_string[ safe_string_index ] <= '9' ) )
+		{
+			safe_string_index++;
+		}
+		/* Positional arguments are not supported
+		 */
+		if( format_string[ safe_string_index ] == '$' )
+		{
+			return( 0 );
+		}
+	}
+	/* Precision
+	 */
+	if( format_string[ safe_string_index ] == '.' )
+	{
+		safe_string_index++;
+
+		has_precision = 1;
+
+		if( format_string[ safe_string_index ] == '*' )
+		{
+			argument_types[ argument_type_index++ ] = LIBCERROR_FORMAT_ARGUMENT_TYPE_INT;
+
+			safe_string_index++;
+		}
+		else
+		{
+			while( ( format_string[ safe_string_index ] >= '0' )
+			    && ( format_string[ safe_string_index ] <= '9' ) )
+			{
+				safe_string_index++;
+			}
+		}
+	}
+	/* Length modifier, where 'H' represents "ll" and 'z' represents size_t
+	 */
+	switch( format_string[ safe_string_index ] )
+	{
+		case 'h':
+			safe_string_index++;
+
+			if( format_string[ safe_string_index ] == 'h' )
+			{
+				safe_string_index++;
+			}
+			length_modifier = 'h';
+
+			break;
+
+		case 'l':
+			safe_string_index++;
+
+			if( format_string[ safe_string_index ] == 'l' )
+			{
+				safe_string_index++;
+
+				length_modifier = 'H';
+			}
+			else
+			{
+				length_modifier = 'l';
+			}
+			break;
+
+		case 'q':
+			safe_string_index++;
+
+			length_modifier = 'H';
+
+			break;
+
+		case 'L':
+		case 'z':
+			length_modifier = format_string[ safe_string_index++ ];
+
+			break;
+
+		case 'I':
+			safe_string_index++;
+
+			if( ( format_string[ safe_string_index ] == '3' )
+			 && ( format_string[ safe_string_index + 1 ] == '2' ) )
+			{
+				safe_string_index += 2;
+
+				length_modifier = 'h';
+			}
+			else if( ( format_string[ safe_string_index ] == '6' )
+			      && ( format_string[ safe_string_index + 1 ] == '4' ) )
+			{
+				safe_string_index += 2;
+
+				length_modifier = 'H';
+			}
+			else
+			{
+				length_modifier = 'z';
+			}
+			break;
+
+		case 'j':
+		case 't':
+			return( 0 );
+
+		default:
+			break;
+	}
+	conversion = format_string[ safe_string_index++ ];
+
+	switch( conversion )
+	{
+		case 'd':
+		case 'i':
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			if( ( length_modifier == 0 )
+			 || ( length_modifier == 'h' ) )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_INT;
+			}
+			else if( length_modifier == 'l' )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG;
+			}
+			else if( length_modifier == 'H' )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_LONG;
+			}
+			else if( length_modifier == 'z' )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_SIZE;
+			}
+			break;
+
+		case 'c':
+			if( length_modifier == 0 )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_INT;
+			}
+			break;
+
+		case 'a':
+		case 'A':
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'F':
+		case 'g':
+		case 'G':
+			if( ( length_modifier == 0 )
+			 || ( length_modifier == 'l' ) )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_DOUBLE;
+			}
+			else if( length_modifier == 'L' )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_DOUBLE;
+			}
+			break;
+
+		case 'p':
+			if( length_modifier == 0 )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_POINTER;
+			}
+			break;
+
+		/* A string with a precision is not required to be terminated
+		 * hence its characters cannot be copied without the precision
+		 */
+		case 's':
+			if( ( length_modifier == 0 )
+			 && ( has_precision == 0 ) )
+			{
+				argument_type = LIBCERROR_FORMAT_ARGUMENT_TYPE_STRING;
+			}
+			break;
+
+		/* Wide characters and strings, %n and unknown conversions are not supported
+		 */
+		default:
+			break;
+	}
+	if( argument_type == 0 )
+	{
+		return( 0 );
+	}
+	/* Leave room to substitute the '*' width and precision
+	 */
+	if( ( safe_string_index - *string_index ) >= LIBCERROR_FORMAT_MAXIMUM_SPECIFICATION_SIZE )
+	{
+		return( 0 );
+	}
+	argument_types[ argument_type_index++ ] = argument_type;
+
+	*string_index             = safe_string_index;
+	*number_of_argument_types = argument_type_index;
+
+	return( 1 );
+}
+
+/* Classifies the conversion specifiers of a format string
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_format_classify(
+     const char *format_string,
+     libcerror_format_scan_t *scan )
+{
+	uint8_t argument_types[ 3 ];
+
+	size_t string_index          = 0;
+	int argument_type_index      = 0;
+	int number_of_argument_types = 0;
+	int result                   = 0;
+
+	if( format_string == NULL )
+	{
+		return( -1 );
+	}
+	if( scan == NULL )
+	{
+		return( -1 );
+	}
+	scan->format_string       = format_string;
+	scan->number_of_arguments = 0;
+
+	while( format_string[ string_index ] != 0 )
+	{
+		if( format_string[ string_index ] != '%' )
+		{
+			string_index++;
+
+			continue;
+		}
+		result = libcerror_format_parse_specification(
+		          format_string,
+		          &string_index,
+		          argument_types,
+		          &number_of_argument_types );
+
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( number_of_argument_types > ( LIBCERROR_FORMAT_MAXIMUM_NUMBER_OF_ARGUMENTS - scan->number_of_arguments ) ) )
+		{
+			scan->number_of_arguments = -1;
+
+			break;
+		}
+		for( argument_type_index = 0;
+		     argument_type_index < number_of_argument_types;
+		     argument_type_index++ )
+		{
+			scan->argument_types[ scan->number_of_arguments++ ] = argument_types[ argument_type_index ];
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the classification of the conversion specifiers of a format string
+ * The classification is cached per format string pointer if thread-local storage is available
+ * hence the format string should not change while the library is in use, e.g. a string literal
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_format_scan(
+     const char *format_string,
+     libcerror_format_scan_t *scan )
+{
+#if defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_format_scan_t *cached_scan = NULL;
+	uintptr_t cache_index                = 0;
+#endif
+
+	if( format_string == NULL )
+	{
+		return( -1 );
+	}
+	if( scan == NULL )
+	{
+		return( -1 );
+	}
+#if defined( LIBCERROR_THREAD_LOCAL )
+	cache_index = (uintptr_t) format_string;
+	cache_index = ( cache_index ^ ( cache_index >> 7 ) ) % LIBCERROR_FORMAT_SCAN_CACHE_SIZE;
+
+	cached_scan = &( libcerror_format_scan_cache[ cache_index ] );
+
+	if( cached_scan->format_string != format_string )
+	{
+		if( libcerror_format_classify(
+		     format_string,
+		     cached_scan ) != 1 )
+		{
+			cached_scan->format_string = NULL;
+
+			return( -1 );
+		}
+	}
+	*scan = *cached_scan;
+
+	return( 1 );
+#else
+	return( libcerror_format_classify(
+	         format_string,
+	         scan ) );
+#endif
+}
+
+/* Determines the size of the packed arguments of a format string
+ * The packed arguments consist of the format string pointer followed by the argument values,
+ * where a string is stored as its size, including the end-of-string character, followed by its characters
+ * Strings are limited to LIBCERROR_MESSAGE_MAXIMUM_SIZE characters since a message is truncated to that size
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_format_get_packed_size(
+     const libcerror_format_scan_t *scan,
+     va_list argument_list,
+     size_t *packed_size )
+{
+	const char *string       = NULL;
+	size_t safe_packed_size  = 0;
+	size_t string_length     = 0;
+	int argument_index       = 0;
+
+	if( scan == NULL )
+	{
+		return( -1 );
+	}
+	if( scan->number_of_arguments < 0 )
+	{
+		return( -1 );
+	}
+	if( packed_size == NULL )
+	{
+		return( -1 );
+	}
+	safe_packed_size = sizeof( const char * );
+
+	for( argument_index = 0;
+	     argument_index < scan->number_of_arguments;
+	     argument_index++ )
+	{
+		switch( scan->argument_types[ argument_index ] )
+		{
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_INT:
+				(void) va_arg(
+				        argument_list,
+				        int );
+
+				safe_packed_size += sizeof( int );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG:
+				(void) va_arg(
+				        argument_list,
+				        long );
+
+				safe_packed_size += sizeof( long );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_LONG:
+				(void) va_arg(
+				        argument_list,
+				        long long );
+
+				safe_packed_size += sizeof( long long );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_SIZE:
+				(void) va_arg(
+				        argument_list,
+				        size_t );
+
+				safe_packed_size += sizeof( size_t );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_DOUBLE:
+				(void) va_arg(
+				        argument_list,
+				        double );
+
+				safe_packed_size += sizeof( double );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_DOUBLE:
+				(void) va_arg(
+				        argument_list,
+				        long double );
+
+				safe_packed_size += sizeof( long double );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_POINTER:
+				(void) va_arg(
+				        argument_list,
+				        void * );
+
+				safe_packed_size += sizeof( void * );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_STRING:
+				string = va_arg(
+				          argument_list,
+				          const char * );
+
+				safe_packed_size += sizeof( size_t );
+
+				if( string != NULL )
+				{
+					for( string_length = 0;
+					     string_length < LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+					     string_length++ )
+					{
+						if( string[ string_length ] == 0 )
+						{
+							break;
+						}
+					}
+					safe_packed_size += string_length + 1;
+				}
+				break;
+
+			default:
+				return( -1 );
+		}
+	}
+	*packed_size = safe_packed_size;
+
+	return( 1 );
+}
+
+/* Packs the arguments of a format string
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_format_pack(
+     const libcerror_format_scan_t *scan,
+     va_list argument_list,
+     uint8_t *packed_data,
+     size_t packed_data_size )
+{
+	const char *string            = NULL;
+	const void *value             = NULL;
+	long double long_double_value = 0.0;
+	void *pointer_value           = NULL;
+	double double_value           = 0.0;
+	long long long_long_value     = 0;
+	size_t packed_data_offset     = 0;
+	size_t size_value             = 0;
+	size_t string_size            = 0;
+	size_t value_size             = 0;
+	long long_value               = 0;
+	int argument_index            = 0;
+	int int_value                 = 0;
+
+	if( scan == NULL )
+	{
+		return( -1 );
+	}
+	if( scan->number_of_arguments < 0 )
+	{
+		return( -1 );
+	}
+	if( packed_data == NULL )
+	{
+		return( -1 );
+	}
+	if( packed_data_size < sizeof( const char * ) )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     packed_data,
+	     &( scan->format_string ),
+	     sizeof( const char * ) ) == NULL )
+	{
+		return( -1 );
+	}
+	packed_data_offset = sizeof( const char * );
+
+	for( argument_index = 0;
+	     argument_index < scan->number_of_arguments;
+	     argument_index++ )
+	{
+		switch( scan->argument_types[ argument_index ] )
+		{
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_INT:
+				int_value = va_arg(
+				             argument_list,
+				             int );
+
+				value      = &int_value;
+				value_size = sizeof( int );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG:
+				long_value = va_arg(
+				              argument_list,
+				              long );
+
+				value      = &long_value;
+				value_size = sizeof( long );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_LONG:
+				long_long_value = va_arg(
+				                   argument_list,
+				                   long long );
+
+				value      = &long_long_value;
+				value_size = sizeof( long long );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_SIZE:
+				size_value = va_arg(
+				              argument_list,
+				              size_t );
+
+				value      = &size_value;
+				value_size = sizeof( size_t );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_DOUBLE:
+				double_value = va_arg(
+				                argument_list,
+				                double );
+
+				value      = &double_value;
+				value_size = sizeof( double );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_DOUBLE:
+				long_double_value = va_arg(
+				                     argument_list,
+				                     long double );
+
+				value      = &long_double_value;
+				value_size = sizeof( long double );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_POINTER:
+				pointer_value = va_arg(
+				                 argument_list,
+				                 void * );
+
+				value      = &pointer_value;
+				value_size = sizeof( void * );
+
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_STRING:
+				string = va_arg(
+				          argument_list,
+				          const char * );
+
+				string_size = 0;
+
+				if( string != NULL )
+				{
+					while( string_size < LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+					{
+						if( string[ string_size ] == 0 )
+						{
+							break;
+						}
+						string_size++;
+					}
+					string_size++;
+				}
+				if( sizeof( size_t ) > ( packed_data_size - packed_data_offset ) )
+				{
+					return( -1 );
+				}
+				if( memory_copy(
+				     &( packed_data[ packed_data_offset ] ),
+				     &string_size,
+				     sizeof( size_t ) ) == NULL )
+				{
+					return( -1 );
+				}
+				packed_data_offset += sizeof( size_t );
+
+				if( string == NULL )
+				{
+					continue;
+				}
+				if( string_size > ( packed_data_size - packed_data_offset ) )
+				{
+					return( -1 );
+				}
+				if( memory_copy(
+				     &( packed_data[ packed_data_offset ] ),
+				     string,
+				     string_size - 1 ) == NULL )
+				{
+					return( -1 );
+				}
+				packed_data_offset += string_size - 1;
+
+				packed_data[ packed_data_offset++ ] = 0;
+
+				continue;
+
+			default:
+				return( -1 );
+		}
+		if( value_size > ( packed_data_size - packed_data_offset ) )
+		{
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( packed_data[ packed_data_offset ] ),
+		     value,
+		     value_size ) == NULL )
+		{
+			return( -1 );
+		}
+		packed_data_offset += value_size;
+	}
+	return( 1 );
+}
+
+/* Prints packed arguments to a string using their format string
+ * The string is always terminated by an end-of-string character
+ * The end-of-string character is not included in the return value
+ * A return value of string size or more means the string was truncated
+ * Returns the number of printed characters if successful or -1 on error
+ */
+int libcerror_format_print_packed(
+     const uint8_t *packed_data,
+     size_t packed_data_size,
+     char *string,
+     size_t string_size )
+{
+	char specification[ LIBCERROR_FORMAT_MAXIMUM_SPECIFICATION_SIZE + 24 ];
+	uint8_t argument_types[ 3 ];
+
+	const char *format_string     = NULL;
+	const char *string_value      = NULL;
+	void *value                   = NULL;
+	long double long_double_value = 0.0;
+	void *pointer_value           = NULL;
+	double double_value           = 0.0;
+	long long long_long_value     = 0;
+	size_t format_string_index    = 0;
+	size_t packed_data_offset     = 0;
+	size_t specification_end      = 0;
+	size_t specification_index    = 0;
+	size_t specification_start    = 0;
+	size_t string_index           = 0;
+	size_t total_print_count      = 0;
+	size_t size_value             = 0;
+	size_t value_size             = 0;
+	long long_value               = 0;
+	int argument_type_index       = 0;
+	int int_value                 = 0;
+	int number_of_argument_types  = 0;
+	int print_count               = 0;
+	int result                    = 0;
+
+	if( packed_data == NULL )
+	{
+		return( -1 );
+	}
+	if( packed_data_size < sizeof( const char * ) )
+	{
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( ( string_size == 0 )
+	 || ( string_size > (size_t) INT_MAX ) )
+	{
+		return( -1 );
+	}
+	if( memory_copy(
+	     &format_string,
+	     packed_data,
+	     sizeof( const char * ) ) == NULL )
+	{
+		return( -1 );
+	}
+	if( format_string == NULL )
+	{
+		return( -1 );
+	}
+	packed_data_offset = sizeof( const char * );
+
+	while( format_string[ format_string_index ] != 0 )
+	{
+		if( format_string[ format_string_index ] != '%' )
+		{
+			if( string_index < ( string_size - 1 ) )
+			{
+				string[ string_index++ ] = format_string[ format_string_index ];
+			}
+			format_string_index++;
+			total_print_count++;
+
+			continue;
+		}
+		specification_start = format_string_index;
+
+		result = libcerror_format_parse_specification(
+		          format_string,
+		          &format_string_index,
+		          argument_types,
+		          &number_of_argument_types );
+
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		if( number_of_argument_types == 0 )
+		{
+			if( string_index < ( string_size - 1 ) )
+			{
+				string[ string_index++ ] = '%';
+			}
+			total_print_count++;
+
+			continue;
+		}
+		specification_end   = format_string_index;
+		specification_index = 0;
+		argument_type_index = 0;
+
+		/* Copy the conversion specification and substitute the '*' width and precision
+		 */
+		while( specification_start < specification_end )
+		{
+			if( format_string[ specification_start ] != '*' )
+			{
+				specification[ specification_index++ ] = format_string[ specification_start++ ];
+
+				continue;
+			}
+			if( sizeof( int ) > ( packed_data_size - packed_data_offset ) )
+			{
+				return( -1 );
+			}
+			if( memory_copy(
+			     &int_value,
+			     &( packed_data[ packed_data_offset ] ),
+			     sizeof( int ) ) == NULL )
+			{
+				return( -1 );
+			}
+			packed_data_offset += sizeof( int );
+
+			argument_type_index++;
+			specification_start++;
+
+			/* A negative precision is taken as if the precision were omitted
+			 */
+			if( ( int_value < 0 )
+			 && ( specification[ specification_index - 1 ] == '.' ) )
+			{
+				specification_index--;
+
+				continue;
+			}
+			print_count = libcerror_format_snprintf(
+			               &( specification[ specification_index ] ),
+			               12,
+			               "%d",
+			               int_value );
+
+			if( ( print_count <= 0 )
+			 || ( print_count >= 12 ) )
+			{
+				return( -1 );
+			}
+			specification_index += (size_t) print_count;
+		}
+		specification[ specification_index ] = 0;
+
+		/* The value of a string argument is its size
+		 */
+		switch( argument_types[ argument_type_index ] )
+		{
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_INT:
+				value      = &int_value;
+				value_size = sizeof( int );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG:
+				value      = &long_value;
+				value_size = sizeof( long );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_LONG:
+				value      = &long_long_value;
+				value_size = sizeof( long long );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_SIZE:
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_STRING:
+				value      = &size_value;
+				value_size = sizeof( size_t );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_DOUBLE:
+				value      = &double_value;
+				value_size = sizeof( double );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_DOUBLE:
+				value      = &long_double_value;
+				value_size = sizeof( long double );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_POINTER:
+				value      = &pointer_value;
+				value_size = sizeof( void * );
+				break;
+
+			default:
+				return( -1 );
+		}
+		if( value_size > ( packed_data_size - packed_data_offset ) )
+		{
+			return( -1 );
+		}
+		if( memory_copy(
+		     value,
+		     &( packed_data[ packed_data_offset ] ),
+		     value_size ) == NULL )
+		{
+			return( -1 );
+		}
+		packed_data_offset += value_size;
+
+		switch( argument_types[ argument_type_index ] )
+		{
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_INT:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               int_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               long_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_LONG:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               long_long_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_SIZE:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               size_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_DOUBLE:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               double_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_DOUBLE:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               long_double_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_POINTER:
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               pointer_value );
+				break;
+
+			case LIBCERROR_FORMAT_ARGUMENT_TYPE_STRING:
+				string_value = NULL;
+
+				if( size_value > 0 )
+				{
+					if( size_value > ( packed_data_size - packed_data_offset ) )
+					{
+						return( -1 );
+					}
+					string_value = (const char *) &( packed_data[ packed_data_offset ] );
+
+					packed_data_offset += size_value;
+				}
+				print_count = libcerror_format_snprintf(
+				               &( string[ string_index ] ),
+				               string_size - string_index,
+				               specification,
+				               string_value );
+				break;
+		}
+		if( print_count <= -1 )
+		{
+#if defined( _MSC_VER )
+			/* _snprintf_s returns -1 when the string was truncated
+			 */
+			print_count = (int) ( string_size - string_index );
+#else
+			return( -1 );
+#endif
+		}
+		total_print_count += (size_t) print_count;
+
+		if( (size_t) print_count < ( string_size - string_index ) )
+		{
+			string_index += (size_t) print_count;
+		}
+		else
+		{
+			string_index = string_size - 1;
+		}
+		if( total_print_count > (size_t) INT_MAX )
+		{
+			return( -1 );
+		}
+	}
+	string[ string_index ] = 0;
+
+	if( total_print_count > (size_t) INT_MAX )
+	{
+		return( -1 );
+	}
+	return( (int) total_print_count );
+}
+
@@ -0,0 +1,99 @@
+/*
+ * Format string functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_FORMAT_H )
+#define _LIBCERROR_FORMAT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
+#include "libcerror_definitions.h"
+#include "libcerror_extern.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libcerror_format_scan libcerror_format_scan_t;
+
+/* The classification of the conversion specifiers of a format string
+ */
+struct libcerror_format_scan
+{
+	/* The format string
+	 */
+	const char *format_string;
+
+	/* The number of arguments
+	 * -1 if the format string contains conversion specifiers that cannot be deferred
+	 */
+	int number_of_arguments;
+
+	/* The argument types
+	 */
+	uint8_t argument_types[ LIBCERROR_FORMAT_MAXIMUM_NUMBER_OF_ARGUMENTS ];
+};
+
+int libcerror_format_parse_specification(
+     const char *format_string,
+     size_t *string_index,
+     uint8_t *argument_types,
+     int *number_of_argument_types );
+
+int libcerror_format_classify(
+     const char *format_string,
+     libcerror_format_scan_t *scan );
+
+int libcerror_format_scan(
+     const char *format_string,
+     libcerror_format_scan_t *scan );
+
+int libcerror_format_get_packed_size(
+     const libcerror_format_scan_t *scan,
+     va_list argument_list,
+     size_t *packed_size );
+
+int libcerror_format_pack(
+     const libcerror_format_scan_t *scan,
+     va_list argument_list,
+     uint8_t *packed_data,
+     size_t packed_data_size );
+
+int libcerror_format_print_packed(
+     const uint8_t *packed_data,
+     size_t packed_data_size,
+     char *string,
+     size_t string_size );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_FORMAT_H ) */
+
@@ -0,0 +1,327 @@
+/*
+ * JSON functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libcerror_json.h"
+
+/* The byte classes used to escape a string, indexed by byte value:
+ * 0 for a byte that is copied as-is
+ * 1 for a byte that is not valid in UTF-8 or as the first byte of a sequence
+ * 2, 3 or 4 for the first byte of a UTF-8 sequence of that size
+ * 'u' for a control character that is escaped as \u00XX
+ * otherwise the character that follows the backslash of a two character escape
+ */
+static const uint8_t libcerror_json_byte_classes[ 256 ] = {
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+	0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	4, 4, 4, 4, 4, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+/* The hexadecimal digits used to escape control characters
+ */
+static const char libcerror_json_hexadecimal_digits[ 16 ] = {
+	'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+
+/* Determines the size of a valid UTF-8 sequence at a specific index in the string
+ * Overlong sequences, surrogates and code points beyond U+10FFFF are not valid
+ * Returns 1 if a valid sequence of 2 to 4 bytes was found, 0 if not or -1 on error
+ */
+int libcerror_json_get_utf8_sequence_size(
+     const uint8_t *string,
+     size_t string_length,
+     size_t string_index,
+     size_t *sequence_size )
+{
+	size_t byte_index   = 0;
+	size_t safe_size    = 0;
+	uint8_t lower_bound = 0x80;
+	uint8_t upper_bound = 0xbf;
+
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( string_index >= string_length )
+	{
+		return( -1 );
+	}
+	if( sequence_size == NULL )
+	{
+		return( -1 );
+	}
+	safe_size = (size_t) libcerror_json_byte_classes[ string[ string_index ] ];
+
+	if( ( safe_size < 2 )
+	 || ( safe_size > 4 ) )
+	{
+		return( 0 );
+	}
+	if( safe_size > ( string_length - string_index ) )
+	{
+		return( 0 );
+	}
+	switch( string[ string_index ] )
+	{
+		case 0xe0:
+			lower_bound = 0xa0;
+			break;
+
+		case 0xed:
+			upper_bound = 0x9f;
+			break;
+
+		case 0xf0:
+			lower_bound = 0x90;
+			break;
+
+		case 0xf4:
+			upper_bound = 0x8f;
+			break;
+
+		default:
+			break;
+	}
+	if( ( string[ string_index + 1 ] < lower_bound )
+	 || ( string[ string_index + 1 ] > upper_bound ) )
+	{
+		return( 0 );
+	}
+	for( byte_index = 2;
+	     byte_index < safe_size;
+	     byte_index++ )
+	{
+		if( ( string[ string_index + byte_index ] & 0xc0 ) != 0x80 )
+		{
+			return( 0 );
+		}
+	}
+	*sequence_size = safe_size;
+
+	return( 1 );
+}
+
+/* Determines the length of a string escaped as the contents of a JSON string
+ * The length does not include the end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_json_get_escaped_string_length(
+     const uint8_t *string,
+     size_t string_length,
+     size_t *escaped_string_length )
+{
+	size_t safe_escaped_string_length = 0;
+	size_t sequence_size              = 0;
+	size_t string_index               = 0;
+	uint8_t byte_class                = 0;
+
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( escaped_string_length == NULL )
+	{
+		return( -1 );
+	}
+	while( string_index < string_length )
+	{
+		byte_class = libcerror_json_byte_classes[ string[ string_index ] ];
+
+		if( byte_class == 0 )
+		{
+			safe_escaped_string_length += 1;
+			string_index               += 1;
+		}
+		else if( byte_class <= 4 )
+		{
+			if( libcerror_json_get_utf8_sequence_size(
+			     string,
+			     string_length,
+			     string_index,
+			     &sequence_size ) == 1 )
+			{
+				safe_escaped_string_length += sequence_size;
+				string_index               += sequence_size;
+			}
+			else
+			{
+				/* An invalid byte is replaced by \ufffd
+				 */
+				safe_escaped_string_length += 6;
+				string_index               += 1;
+			}
+		}
+		else if( byte_class == (uint8_t) 'u' )
+		{
+			safe_escaped_string_length += 6;
+			string_index               += 1;
+		}
+		else
+		{
+			safe_escaped_string_length += 2;
+			string_index               += 1;
+		}
+	}
+	*escaped_string_length = safe_escaped_string_length;
+
+	return( 1 );
+}
+
+/* Escapes a string as the contents of a JSON string
+ * Valid UTF-8 sequences are copied, control characters, quotation marks and backslashes
+ * are escaped and bytes that are not valid UTF-8 are replaced by \ufffd, the escaped
+ * replacement character, hence the escaped string is always valid UTF-8
+ * The string is escaped from the string index until the escaped string is full, where an escape
+ * is never split, hence the escaping can be continued with another escaped string buffer
+ * The escaped string is not terminated by an end-of-string character
+ * Returns 1 if the entire string was escaped, 0 if the escaped string is full or -1 on error
+ */
+int libcerror_json_escape_string(
+     const uint8_t *string,
+     size_t string_length,
+     size_t *string_index,
+     char *escaped_string,
+     size_t escaped_string_size,
+     size_t *escaped_string_index )
+{
+	size_t safe_escaped_string_index = 0;
+	size_t safe_string_index         = 0;
+	size_t sequence_size             = 0;
+	uint8_t byte_class               = 0;
+	uint8_t byte_value               = 0;
+
+	if( string == NULL )
+	{
+		return( -1 );
+	}
+	if( string_index == NULL )
+	{
+		return( -1 );
+	}
+	if( escaped_string == NULL )
+	{
+		return( -1 );
+	}
+	if( escaped_string_index == NULL )
+	{
+		return( -1 );
+	}
+	safe_string_index         = *string_index;
+	safe_escaped_string_index = *escaped_string_index;
+
+	if( safe_escaped_string_index > escaped_string_size )
+	{
+		return( -1 );
+	}
+	while( safe_string_index < string_length )
+	{
+		byte_value = string[ safe_string_index ];
+		byte_class = libcerror_json_byte_classes[ byte_value ];
+
+		if( byte_class == 0 )
+		{
+			if( ( escaped_string_size - safe_escaped_string_index ) < 1 )
+			{
+				break;
+			}
+			escaped_string[ safe_escaped_string_index++ ] = (char) byte_value;
+
+			safe_string_index += 1;
+		}
+		else if( ( byte_class <= 4 )
+		      && ( libcerror_json_get_utf8_sequence_size(
+		            string,
+		            string_length,
+		            safe_string_index,
+		            &sequence_size ) == 1 ) )
+		{
+			if( ( escaped_string_size - safe_escaped_string_index ) < sequence_size )
+			{
+				break;
+			}
+			while( sequence_size > 0 )
+			{
+				escaped_string[ safe_escaped_string_index++ ] = (char) string[ safe_string_index++ ];
+
+				sequence_size--;
+			}
+		}
+		else if( ( byte_class <= 4 )
+		      || ( byte_class == (uint8_t) 'u' ) )
+		{
+			if( ( escaped_string_size - safe_escaped_string_index ) < 6 )
+			{
+				break;
+			}
+			escaped_string[ safe_escaped_string_index++ ] = '\\';
+			escaped_string[ safe_escaped_string_index++ ] = 'u';
+
+			if( byte_class <= 4 )
+			{
+				escaped_string[ safe_escaped_string_index++ ] = 'f';
+				escaped_string[ safe_escaped_string_index++ ] = 'f';
+				escaped_string[ safe_escaped_string_index++ ] = 'f';
+				escaped_string[ safe_escaped_string_index++ ] = 'd';
+			}
+			else
+			{
+				escaped_string[ safe_escaped_string_index++ ] = '0';
+				escaped_string[ safe_escaped_string_index++ ] = '0';
+				escaped_string[ safe_escaped_string_index++ ] = libcerror_json_hexadecimal_digits[ byte_value >> 4 ];
+				escaped_string[ safe_escaped_string_index++ ] = libcerror_json_hexadecimal_digits[ byte_value & 0x0f ];
+			}
+			safe_string_index += 1;
+		}
+		else
+		{
+			if( ( escaped_string_size - safe_escaped_string_index ) < 2 )
+			{
+				break;
+			}
+			escaped_string[ safe_escaped_string_index++ ] = '\\';
+			escaped_string[ safe_escaped_string_index++ ] = (char) byte_class;
+
+			safe_string_index += 1;
+		}
+	}
+	*string_index         = safe_string_index;
+	*escaped_string_index = safe_escaped_string_index;
+
+	if( safe_string_index < string_length )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,56 @@
+/*
+ * JSON functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_JSON_H )
+#define _LIBCERROR_JSON_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libcerror_json_get_utf8_sequence_size(
+     const uint8_t *string,
+     size_t string_length,
+     size_t string_index,
+     size_t *sequence_size );
+
+int libcerror_json_get_escaped_string_length(
+     const uint8_t *string,
+     size_t string_length,
+     size_t *escaped_string_length );
+
+int libcerror_json_escape_string(
+     const uint8_t *string,
+     size_t string_length,
+     size_t *string_index,
+     char *escaped_string,
+     size_t escaped_string_size,
+     size_t *escaped_string_index );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_JSON_H ) */
+
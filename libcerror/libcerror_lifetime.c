@@ -0,0 +1,339 @@
+/*
+ * Error lifetime statistics functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+#include <time.h>
+#endif
+
+#include "libcerror_definitions.h"
+#include "libcerror_lifetime.h"
+
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+
+/* The error lifetime histogram
+ * The counters are updated with relaxed atomic operations, hence they are not
+ * ordered with respect to each other
+ */
+static uint64_t libcerror_lifetime_lifetime_counters[ LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS ];
+
+/* The error depth histogram
+ */
+static uint64_t libcerror_lifetime_depth_counters[ LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS ];
+
+/* Retrieves a timestamp of the monotonic clock
+ * Returns the timestamp in nanoseconds or 0 if not available
+ */
+uint64_t libcerror_lifetime_get_timestamp(
+          void )
+{
+	struct timespec time_value;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+}
+
+/* Records the lifetime and final depth of an error that is freed
+ * The lifetime is not recorded if the creation time is not available
+ */
+void libcerror_lifetime_record(
+      uint64_t creation_time,
+      int depth )
+{
+	uint64_t lifetime  = 0;
+	uint64_t timestamp = 0;
+	int bucket_index   = 0;
+
+	if( creation_time != 0 )
+	{
+		timestamp = libcerror_lifetime_get_timestamp();
+
+		if( timestamp > creation_time )
+		{
+			lifetime = timestamp - creation_time;
+		}
+		if( lifetime > 1 )
+		{
+			bucket_index = 63 - __builtin_clzll(
+			                     (unsigned long long) lifetime );
+
+			if( bucket_index >= LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS )
+			{
+				bucket_index = LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS - 1;
+			}
+		}
+		__atomic_fetch_add(
+		 &( libcerror_lifetime_lifetime_counters[ bucket_index ] ),
+		 1,
+		 __ATOMIC_RELAXED );
+	}
+	bucket_index = 0;
+
+	if( depth > 0 )
+	{
+		bucket_index = 32 - __builtin_clz(
+		                     (unsigned int) depth );
+
+		if( bucket_index >= LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS )
+		{
+			bucket_index = LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS - 1;
+		}
+	}
+	__atomic_fetch_add(
+	 &( libcerror_lifetime_depth_counters[ bucket_index ] ),
+	 1,
+	 __ATOMIC_RELAXED );
+}
+
+#endif /* defined( HAVE_ERROR_LIFETIME_STATISTICS ) */
+
+/* Retrieves the error lifetime histogram
+ * Bucket N contains the number of errors that lived 2^N up to 2^(N+1) nanoseconds
+ * where bucket 0 also contains the errors that lived less than 1 nanosecond
+ * and the last bucket also contains the errors that lived longer
+ * Returns 1 if successful, 0 if the lifetime statistics are not available or -1 on error
+ */
+int libcerror_lifetime_get_lifetime_histogram(
+     uint64_t *counts,
+     int maximum_number_of_buckets,
+     int *number_of_buckets )
+{
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	int bucket_index = 0;
+#endif
+
+	if( counts == NULL )
+	{
+		return( -1 );
+	}
+	if( maximum_number_of_buckets < 0 )
+	{
+		return( -1 );
+	}
+	if( number_of_buckets == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	for( bucket_index = 0;
+	     bucket_index < LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS;
+	     bucket_index++ )
+	{
+		if( bucket_index >= maximum_number_of_buckets )
+		{
+			break;
+		}
+		counts[ bucket_index ] = __atomic_load_n(
+		                          &( libcerror_lifetime_lifetime_counters[ bucket_index ] ),
+		                          __ATOMIC_RELAXED );
+	}
+	*number_of_buckets = bucket_index;
+
+	return( 1 );
+#else
+	*number_of_buckets = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_LIFETIME_STATISTICS ) */
+}
+
+/* Retrieves the error depth histogram
+ * Bucket 0 contains the number of errors that were freed without messages
+ * bucket N the number of errors that were freed with 2^(N-1) up to 2^N messages
+ * and the last bucket also contains the errors with more messages
+ * Returns 1 if successful, 0 if the lifetime statistics are not available or -1 on error
+ */
+int libcerror_lifetime_get_depth_histogram(
+     uint64_t *counts,
+     int maximum_number_of_buckets,
+     int *number_of_buckets )
+{
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	int bucket_index = 0;
+#endif
+
+	if( counts == NULL )
+	{
+		return( -1 );
+	}
+	if( maximum_number_of_buckets < 0 )
+	{
+		return( -1 );
+	}
+	if( number_of_buckets == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	for( bucket_index = 0;
+	     bucket_index < LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS;
+	     bucket_index++ )
+	{
+		if( bucket_index >= maximum_number_of_buckets )
+		{
+			break;
+		}
+		counts[ bucket_index ] = __atomic_load_n(
+		                          &( libcerror_lifetime_depth_counters[ bucket_index ] ),
+		                          __ATOMIC_RELAXED );
+	}
+	*number_of_buckets = bucket_index;
+
+	return( 1 );
+#else
+	*number_of_buckets = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_LIFETIME_STATISTICS ) */
+}
+
+/* Prints the error lifetime and depth histograms to a stream
+ * Only the buckets that contain errors are printed
+ * Returns 1 if successful, 0 if the lifetime statistics are not available or -1 on error
+ */
+int libcerror_lifetime_fprint(
+     FILE *stream )
+{
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	uint64_t count   = 0;
+	int bucket_index = 0;
+	int print_count  = 0;
+#endif
+
+	if( stream == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	print_count = fprintf(
+	               stream,
+	               "Error lifetime (nanoseconds):\n" );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS;
+	     bucket_index++ )
+	{
+		count = __atomic_load_n(
+		         &( libcerror_lifetime_lifetime_counters[ bucket_index ] ),
+		         __ATOMIC_RELAXED );
+
+		if( count == 0 )
+		{
+			continue;
+		}
+		print_count = fprintf(
+		               stream,
+		               "\t>= %" PRIu64 "\t: %" PRIu64 "\n",
+		               (uint64_t) 1 << bucket_index,
+		               count );
+
+		if( print_count <= -1 )
+		{
+			return( -1 );
+		}
+	}
+	print_count = fprintf(
+	               stream,
+	               "Error depth:\n" );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS;
+	     bucket_index++ )
+	{
+		count = __atomic_load_n(
+		         &( libcerror_lifetime_depth_counters[ bucket_index ] ),
+		         __ATOMIC_RELAXED );
+
+		if( count == 0 )
+		{
+			continue;
+		}
+		print_count = fprintf(
+		               stream,
+		               "\t>= %d\t: %" PRIu64 "\n",
+		               ( bucket_index == 0 ) ? 0 : 1 << ( bucket_index - 1 ),
+		               count );
+
+		if( print_count <= -1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_LIFETIME_STATISTICS ) */
+}
+
+/* Resets the error lifetime and depth histograms
+ * Returns 1 if successful, 0 if the lifetime statistics are not available or -1 on error
+ */
+int libcerror_lifetime_reset(
+     void )
+{
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+	int bucket_index = 0;
+
+	for( bucket_index = 0;
+	     bucket_index < LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS;
+	     bucket_index++ )
+	{
+		__atomic_store_n(
+		 &( libcerror_lifetime_lifetime_counters[ bucket_index ] ),
+		 0,
+		 __ATOMIC_RELAXED );
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS;
+	     bucket_index++ )
+	{
+		__atomic_store_n(
+		 &( libcerror_lifetime_depth_counters[ bucket_index ] ),
+		 0,
+		 __ATOMIC_RELAXED );
+	}
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_LIFETIME_STATISTICS ) */
+}
+
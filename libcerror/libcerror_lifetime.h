@@ -0,0 +1,73 @@
+/*
+ * Error lifetime statistics functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_LIFETIME_H )
+#define _LIBCERROR_LIFETIME_H
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#include "libcerror_definitions.h"
+#include "libcerror_extern.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_ERROR_LIFETIME_STATISTICS )
+
+uint64_t libcerror_lifetime_get_timestamp(
+          void );
+
+void libcerror_lifetime_record(
+      uint64_t creation_time,
+      int depth );
+
+#endif /* defined( HAVE_ERROR_LIFETIME_STATISTICS ) */
+
+LIBCERROR_EXTERN \
+int libcerror_lifetime_get_lifetime_histogram(
+     uint64_t *counts,
+     int maximum_number_of_buckets,
+     int *number_of_buckets );
+
+LIBCERROR_EXTERN \
+int libcerror_lifetime_get_depth_histogram(
+     uint64_t *counts,
+     int maximum_number_of_buckets,
+     int *number_of_buckets );
+
+LIBCERROR_EXTERN \
+int libcerror_lifetime_fprint(
+     FILE *stream );
+
+LIBCERROR_EXTERN \
+int libcerror_lifetime_reset(
+     void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_LIFETIME_H ) */
+
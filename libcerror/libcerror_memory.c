@@ -0,0 +1,169 @@
+/*
+ * Memory functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcerror_memory.h"
+#include "libcerror_pool.h"
+
+/* The memory functions set by libcerror_set_memory_functions
+ */
+static void *(*libcerror_memory_allocate_function)(
+               size_t size,
+               void *context ) = NULL;
+
+static void *(*libcerror_memory_reallocate_function)(
+               void *memory,
+               size_t size,
+               void *context ) = NULL;
+
+static void (*libcerror_memory_free_function)(
+              void *memory,
+              void *context ) = NULL;
+
+static void *libcerror_memory_context = NULL;
+
+/* Allocates memory
+ * Returns a pointer to the allocated memory or NULL on error
+ */
+void *libcerror_memory_allocate(
+       size_t size )
+{
+	if( libcerror_memory_allocate_function != NULL )
+	{
+		return( libcerror_memory_allocate_function(
+		         size,
+		         libcerror_memory_context ) );
+	}
+	return( memory_allocate(
+	         size ) );
+}
+
+/* Reallocates memory
+ * If memory is NULL the memory is allocated
+ * Returns a pointer to the reallocated memory or NULL on error
+ */
+void *libcerror_memory_reallocate(
+       void *memory,
+       size_t size )
+{
+	if( memory == NULL )
+	{
+		return( libcerror_memory_allocate(
+		         size ) );
+	}
+	if( libcerror_memory_reallocate_function != NULL )
+	{
+		return( libcerror_memory_reallocate_function(
+		         memory,
+		         size,
+		         libcerror_memory_context ) );
+	}
+	return( memory_reallocate(
+	         memory,
+	         size ) );
+}
+
+/* Frees memory
+ */
+void libcerror_memory_free(
+      void *memory )
+{
+	if( memory == NULL )
+	{
+		return;
+	}
+	if( libcerror_memory_free_function != NULL )
+	{
+		libcerror_memory_free_function(
+		 memory,
+		 libcerror_memory_context );
+	}
+	else
+	{
+		memory_free(
+		 memory );
+	}
+}
+
+/* Determines if memory functions other than the default are set
+ * Returns 1 if set or 0 if not
+ */
+int libcerror_memory_has_functions(
+     void )
+{
+	if( libcerror_memory_free_function != NULL )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the memory functions used for all the allocations of libcerror
+ * The context is passed to the memory functions
+ * The reallocate function is never called with a NULL pointer and the free function
+ * is never called with a NULL pointer
+ * Either all the functions are set or none, in which case the default memory functions are restored
+ * The memory functions apply to all threads and must be set while no errors exist
+ * The pool of freed errors is not used while the memory functions are set, since
+ * the errors kept in the pools of other threads were allocated with the default memory functions
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_set_memory_functions(
+     void *(*allocate_function)(
+             size_t size,
+             void *context ),
+     void *(*reallocate_function)(
+             void *memory,
+             size_t size,
+             void *context ),
+     void (*free_function)(
+            void *memory,
+            void *context ),
+     void *context )
+{
+	if( ( allocate_function == NULL )
+	 && ( reallocate_function == NULL )
+	 && ( free_function == NULL ) )
+	{
+		if( context != NULL )
+		{
+			return( -1 );
+		}
+	}
+	else if( ( allocate_function == NULL )
+	      || ( reallocate_function == NULL )
+	      || ( free_function == NULL ) )
+	{
+		return( -1 );
+	}
+	libcerror_pool_flush();
+
+	libcerror_memory_allocate_function   = allocate_function;
+	libcerror_memory_reallocate_function = reallocate_function;
+	libcerror_memory_free_function       = free_function;
+	libcerror_memory_context             = context;
+
+	return( 1 );
+}
+
@@ -0,0 +1,320 @@
+/*
+ * Error pool functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERROR_POOL ) && defined( HAVE_PTHREAD_H )
+#include <pthread.h>
+#endif
+
+#include "libcerror_definitions.h"
+#include "libcerror_memory.h"
+#include "libcerror_pool.h"
+
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+
+/* The pool of the current thread
+ */
+static LIBCERROR_THREAD_LOCAL libcerror_pool_t libcerror_pool_thread_pool;
+
+/* The key used to flush the pool on thread exit
+ */
+static pthread_key_t libcerror_pool_key;
+
+static pthread_once_t libcerror_pool_key_once = PTHREAD_ONCE_INIT;
+
+static int libcerror_pool_key_is_created      = 0;
+
+/* The statistics of the pools that were flushed
+ */
+static pthread_mutex_t libcerror_pool_statistics_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t libcerror_pool_number_of_requests      = 0;
+static uint64_t libcerror_pool_number_of_hits          = 0;
+static uint64_t libcerror_pool_number_of_returns       = 0;
+static uint64_t libcerror_pool_number_of_kept_returns  = 0;
+
+/* Flushes the pool of a thread that exits
+ */
+void libcerror_pool_free_thread_pool(
+      void *pool )
+{
+	if( pool == NULL )
+	{
+		return;
+	}
+	libcerror_pool_flush();
+
+	/* Register again if the pool is used by another thread-specific data destructor
+	 */
+	( (libcerror_pool_t *) pool )->is_registered = 0;
+}
+
+/* Creates the key used to flush the pool on thread exit
+ */
+void libcerror_pool_create_key(
+      void )
+{
+	if( pthread_key_create(
+	     &libcerror_pool_key,
+	     &libcerror_pool_free_thread_pool ) == 0 )
+	{
+		libcerror_pool_key_is_created = 1;
+	}
+}
+
+/* Flushes the pool of the current thread and deletes the key used to flush the pool on thread exit
+ * This function is called when the library is unloaded, since the key references
+ * libcerror_pool_free_thread_pool, which is no longer available after unloading
+ * Without compiler support for a destructor function the library must not be unloaded
+ */
+void libcerror_pool_finalize(
+      void )
+{
+	libcerror_pool_flush();
+
+	if( libcerror_pool_key_is_created != 0 )
+	{
+		libcerror_pool_key_is_created = 0;
+
+		pthread_key_delete(
+		 libcerror_pool_key );
+	}
+}
+
+#endif /* defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+
+/* Retrieves a block from the pool of the current thread
+ * Returns the block or NULL if the pool is empty or memory functions are set
+ */
+void *libcerror_pool_get_block(
+       void )
+{
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_pool_t *pool = &libcerror_pool_thread_pool;
+	int size_class         = 0;
+
+	/* The blocks in the pool were allocated with the default memory functions
+	 */
+	if( libcerror_memory_has_functions() != 0 )
+	{
+		return( NULL );
+	}
+	pool->number_of_requests += 1;
+
+	for( size_class = 0;
+	     size_class < LIBCERROR_POOL_NUMBER_OF_SIZE_CLASSES;
+	     size_class++ )
+	{
+		if( pool->number_of_blocks[ size_class ] > 0 )
+		{
+			pool->number_of_blocks[ size_class ] -= 1;
+			pool->number_of_hits                 += 1;
+
+			return( pool->blocks[ size_class ][ pool->number_of_blocks[ size_class ] ] );
+		}
+	}
+#endif /* defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+
+	return( NULL );
+}
+
+/* Returns a block to the pool of the current thread
+ * A block is not kept in the pool while memory functions are set
+ * Returns 1 if the block was kept in the pool, 0 if not or -1 on error
+ */
+int libcerror_pool_put_block(
+     void *block,
+     size_t block_size )
+{
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_pool_t *pool = &libcerror_pool_thread_pool;
+	size_t class_size      = LIBCERROR_POOL_SMALLEST_SIZE_CLASS;
+	int size_class         = 0;
+#endif
+
+	if( block == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+	if( libcerror_memory_has_functions() != 0 )
+	{
+		return( 0 );
+	}
+	pool->number_of_returns += 1;
+
+	/* Each size class is 4 times larger than the previous one
+	 */
+	while( block_size > class_size )
+	{
+		size_class++;
+
+		if( size_class >= LIBCERROR_POOL_NUMBER_OF_SIZE_CLASSES )
+		{
+			return( 0 );
+		}
+		class_size *= 4;
+	}
+	if( pool->number_of_blocks[ size_class ] >= LIBCERROR_POOL_MAXIMUM_NUMBER_OF_BLOCKS )
+	{
+		return( 0 );
+	}
+	if( pool->is_registered == 0 )
+	{
+		if( pthread_once(
+		     &libcerror_pool_key_once,
+		     &libcerror_pool_create_key ) != 0 )
+		{
+			return( 0 );
+		}
+		if( libcerror_pool_key_is_created == 0 )
+		{
+			return( 0 );
+		}
+		if( pthread_setspecific(
+		     libcerror_pool_key,
+		     pool ) != 0 )
+		{
+			return( 0 );
+		}
+		pool->is_registered = 1;
+	}
+	/* The key was deleted when the library was finalized
+	 */
+	else if( libcerror_pool_key_is_created == 0 )
+	{
+		return( 0 );
+	}
+	pool->blocks[ size_class ][ pool->number_of_blocks[ size_class ] ] = block;
+
+	pool->number_of_blocks[ size_class ] += 1;
+	pool->number_of_kept_returns         += 1;
+
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+}
+
+/* Frees the blocks in the pool of the current thread
+ * The blocks are freed with the default memory functions they were allocated with
+ */
+void libcerror_pool_flush(
+      void )
+{
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_pool_t *pool = &libcerror_pool_thread_pool;
+	int size_class         = 0;
+
+	for( size_class = 0;
+	     size_class < LIBCERROR_POOL_NUMBER_OF_SIZE_CLASSES;
+	     size_class++ )
+	{
+		while( pool->number_of_blocks[ size_class ] > 0 )
+		{
+			pool->number_of_blocks[ size_class ] -= 1;
+
+			memory_free(
+			 pool->blocks[ size_class ][ pool->number_of_blocks[ size_class ] ] );
+		}
+	}
+	if( pthread_mutex_lock(
+	     &libcerror_pool_statistics_mutex ) == 0 )
+	{
+		libcerror_pool_number_of_requests     += pool->number_of_requests;
+		libcerror_pool_number_of_hits         += pool->number_of_hits;
+		libcerror_pool_number_of_returns      += pool->number_of_returns;
+		libcerror_pool_number_of_kept_returns += pool->number_of_kept_returns;
+
+		pthread_mutex_unlock(
+		 &libcerror_pool_statistics_mutex );
+
+		pool->number_of_requests     = 0;
+		pool->number_of_hits         = 0;
+		pool->number_of_returns      = 0;
+		pool->number_of_kept_returns = 0;
+	}
+#endif /* defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+}
+
+/* Retrieves the pool statistics
+ * The statistics consist of those of the current thread and of the threads that have exited
+ * The hit rate is the number of hits divided by the number of requests
+ * Returns 1 if successful, 0 if the pool is not available or -1 on error
+ */
+int libcerror_pool_get_statistics(
+     uint64_t *number_of_requests,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_returns,
+     uint64_t *number_of_kept_returns )
+{
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_pool_t *pool = &libcerror_pool_thread_pool;
+#endif
+
+	if( number_of_requests == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_returns == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_kept_returns == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+	if( pthread_mutex_lock(
+	     &libcerror_pool_statistics_mutex ) != 0 )
+	{
+		return( -1 );
+	}
+	*number_of_requests     = libcerror_pool_number_of_requests + pool->number_of_requests;
+	*number_of_hits         = libcerror_pool_number_of_hits + pool->number_of_hits;
+	*number_of_returns      = libcerror_pool_number_of_returns + pool->number_of_returns;
+	*number_of_kept_returns = libcerror_pool_number_of_kept_returns + pool->number_of_kept_returns;
+
+	if( pthread_mutex_unlock(
+	     &libcerror_pool_statistics_mutex ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+#else
+	*number_of_requests     = 0;
+	*number_of_hits         = 0;
+	*number_of_returns      = 0;
+	*number_of_kept_returns = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+}
+
@@ -0,0 +1,112 @@
+/*
+ * Error pool functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_POOL_H )
+#define _LIBCERROR_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcerror_definitions.h"
+#include "libcerror_extern.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+
+typedef struct libcerror_pool libcerror_pool_t;
+
+/* The thread-local pool of freed errors
+ * An error is a single block of memory, hence the pool contains blocks of memory
+ * by size class
+ */
+struct libcerror_pool
+{
+	/* The blocks per size class
+	 */
+	void *blocks[ LIBCERROR_POOL_NUMBER_OF_SIZE_CLASSES ][ LIBCERROR_POOL_MAXIMUM_NUMBER_OF_BLOCKS ];
+
+	/* The number of blocks per size class
+	 */
+	int number_of_blocks[ LIBCERROR_POOL_NUMBER_OF_SIZE_CLASSES ];
+
+	/* Value to indicate the pool is flushed on thread exit
+	 */
+	int is_registered;
+
+	/* The number of block requests
+	 */
+	uint64_t number_of_requests;
+
+	/* The number of block requests satisfied by the pool
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of blocks returned to the pool
+	 */
+	uint64_t number_of_returns;
+
+	/* The number of blocks returned to the pool that were kept
+	 */
+	uint64_t number_of_kept_returns;
+};
+
+void libcerror_pool_free_thread_pool(
+      void *pool );
+
+void libcerror_pool_create_key(
+      void );
+
+#if defined( __GNUC__ )
+void libcerror_pool_finalize(
+      void ) __attribute__((destructor));
+#else
+void libcerror_pool_finalize(
+      void );
+#endif
+
+#endif /* defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+
+void *libcerror_pool_get_block(
+       void );
+
+int libcerror_pool_put_block(
+     void *block,
+     size_t block_size );
+
+void libcerror_pool_flush(
+      void );
+
+LIBCERROR_EXTERN \
+int libcerror_pool_get_statistics(
+     uint64_t *number_of_requests,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_returns,
+     uint64_t *number_of_kept_returns );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_POOL_H ) */
+
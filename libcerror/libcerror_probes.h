@@ -0,0 +1,73 @@
+/*
+ * USDT probe definitions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_PROBES_H )
+#define _LIBCERROR_PROBES_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_USDT_PROBES )
+#include <sys/sdt.h>
+#endif
+
+#include "libcerror_definitions.h"
+
+#if defined( HAVE_USDT_PROBES )
+
+/* The last message of an internal error or NULL if not available
+ * A deferred message is not formatted, hence NULL is used instead
+ */
+#define LIBCERROR_PROBE_LAST_MESSAGE( internal_error ) \
+	( ( ( internal_error )->number_of_messages > 0 ) \
+	 && ( ( ( internal_error )->flags[ ( internal_error )->number_of_messages - 1 ] & LIBCERROR_MESSAGE_FLAG_DEFERRED ) == 0 ) \
+	 ? ( internal_error )->messages[ ( internal_error )->number_of_messages - 1 ] : NULL )
+
+/* Probe fired when an error is created
+ */
+#define LIBCERROR_PROBE_ERROR_INITIALIZE( error_domain, error_code ) \
+	DTRACE_PROBE2( libcerror, error__initialize, error_domain, error_code )
+
+/* Probe fired when a message is set by libcerror_error_set or libcerror_error_set_static
+ */
+#define LIBCERROR_PROBE_ERROR_SET( error_domain, error_code, internal_error ) \
+	DTRACE_PROBE4( libcerror, error__set, error_domain, error_code, ( internal_error )->number_of_messages, LIBCERROR_PROBE_LAST_MESSAGE( internal_error ) )
+
+/* Probe fired when an error is freed
+ */
+#define LIBCERROR_PROBE_ERROR_FREE( internal_error ) \
+	DTRACE_PROBE4( libcerror, error__free, ( internal_error )->domain, ( internal_error )->code, ( internal_error )->number_of_messages, LIBCERROR_PROBE_LAST_MESSAGE( internal_error ) )
+
+/* Probe fired when a message is set by libcerror_system_set_error
+ */
+#define LIBCERROR_PROBE_SYSTEM_SET_ERROR( error_domain, error_code, internal_error, system_error_code ) \
+	DTRACE_PROBE5( libcerror, system__set__error, error_domain, error_code, ( internal_error )->number_of_messages, LIBCERROR_PROBE_LAST_MESSAGE( internal_error ), system_error_code )
+
+#else
+#define LIBCERROR_PROBE_ERROR_INITIALIZE( error_domain, error_code )
+#define LIBCERROR_PROBE_ERROR_SET( error_domain, error_code, internal_error )
+#define LIBCERROR_PROBE_ERROR_FREE( internal_error )
+#define LIBCERROR_PROBE_SYSTEM_SET_ERROR( error_domain, error_code, internal_error, system_error_code )
+
+#endif /* defined( HAVE_USDT_PROBES ) */
+
+#endif /* !defined( _LIBCERROR_PROBES_H ) */
+
@@ -0,0 +1,437 @@
+/*
+ * Live error registry functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_ERROR_REGISTRY )
+#include <pthread.h>
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#endif /* defined( HAVE_ERROR_REGISTRY ) */
+
+#include "libcerror_definitions.h"
+#include "libcerror_error.h"
+#include "libcerror_registry.h"
+#include "libcerror_types.h"
+#include "libcerror_unused.h"
+
+#if defined( HAVE_ERROR_REGISTRY )
+
+typedef struct libcerror_registry_shard libcerror_registry_shard_t;
+
+/* A shard of the live error registry
+ * The live errors are sharded by address to reduce contention between threads
+ */
+struct libcerror_registry_shard
+{
+	/* The mutex that protects the shard
+	 */
+	pthread_mutex_t mutex;
+
+	/* The first live error
+	 */
+	libcerror_internal_error_t *first_live_error;
+
+	/* The number of live errors
+	 */
+	int number_of_live_errors;
+};
+
+/* The shards of the live error registry
+ */
+static libcerror_registry_shard_t libcerror_registry_shards[ LIBCERROR_REGISTRY_NUMBER_OF_SHARDS ];
+
+static pthread_once_t libcerror_registry_shards_once = PTHREAD_ONCE_INIT;
+
+/* The stream to which the live errors are printed at exit
+ */
+static FILE *libcerror_registry_exit_stream = NULL;
+
+static pthread_once_t libcerror_registry_exit_once = PTHREAD_ONCE_INIT;
+
+/* Initializes the mutexes of the shards
+ */
+void libcerror_registry_initialize_shards(
+      void )
+{
+	int shard_index = 0;
+
+	for( shard_index = 0;
+	     shard_index < LIBCERROR_REGISTRY_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		pthread_mutex_init(
+		 &( libcerror_registry_shards[ shard_index ].mutex ),
+		 NULL );
+	}
+}
+
+/* Retrieves the shard of an error
+ * Returns the shard or NULL if not available
+ */
+libcerror_registry_shard_t *libcerror_registry_get_shard(
+                             libcerror_internal_error_t *internal_error )
+{
+	if( pthread_once(
+	     &libcerror_registry_shards_once,
+	     &libcerror_registry_initialize_shards ) != 0 )
+	{
+		return( NULL );
+	}
+	/* The lower bits of the address are the same due to the alignment of the allocation
+	 */
+	return( &( libcerror_registry_shards[ ( (uintptr_t) internal_error >> 4 ) % LIBCERROR_REGISTRY_NUMBER_OF_SHARDS ] ) );
+}
+
+/* Inserts an error into the live error registry
+ */
+void libcerror_registry_insert(
+      libcerror_internal_error_t *internal_error )
+{
+	libcerror_registry_shard_t *shard = NULL;
+
+	if( internal_error == NULL )
+	{
+		return;
+	}
+	internal_error->previous_live_error = NULL;
+	internal_error->next_live_error     = NULL;
+
+	shard = libcerror_registry_get_shard(
+	         internal_error );
+
+	if( shard == NULL )
+	{
+		return;
+	}
+	if( pthread_mutex_lock(
+	     &( shard->mutex ) ) != 0 )
+	{
+		return;
+	}
+	if( shard->first_live_error != NULL )
+	{
+		shard->first_live_error->previous_live_error = internal_error;
+	}
+	internal_error->next_live_error = shard->first_live_error;
+	internal_error->is_live         = 1;
+
+	shard->first_live_error       = internal_error;
+	shard->number_of_live_errors += 1;
+
+	pthread_mutex_unlock(
+	 &( shard->mutex ) );
+}
+
+/* Removes an error from the live error registry
+ */
+void libcerror_registry_remove(
+      libcerror_internal_error_t *internal_error )
+{
+	libcerror_registry_shard_t *shard = NULL;
+
+	if( internal_error == NULL )
+	{
+		return;
+	}
+	if( internal_error->is_live == 0 )
+	{
+		return;
+	}
+	shard = libcerror_registry_get_shard(
+	         internal_error );
+
+	if( shard == NULL )
+	{
+		return;
+	}
+	if( pthread_mutex_lock(
+	     &( shard->mutex ) ) != 0 )
+	{
+		return;
+	}
+	if( internal_error->previous_live_error != NULL )
+	{
+		internal_error->previous_live_error->next_live_error = internal_error->next_live_error;
+	}
+	else
+	{
+		shard->first_live_error = internal_error->next_live_error;
+	}
+	if( internal_error->next_live_error != NULL )
+	{
+		internal_error->next_live_error->previous_live_error = internal_error->previous_live_error;
+	}
+	internal_error->previous_live_error = NULL;
+	internal_error->next_live_error     = NULL;
+	internal_error->is_live             = 0;
+
+	shard->number_of_live_errors -= 1;
+
+	pthread_mutex_unlock(
+	 &( shard->mutex ) );
+}
+
+/* Sets the creation site of an error
+ * The creation site is only set the first time, which is when the error is created
+ */
+void libcerror_registry_set_creation_site(
+      libcerror_error_t *error,
+      const void *creation_address,
+      libcerror_callsite_t *creation_callsite )
+{
+	libcerror_internal_error_t *internal_error = NULL;
+
+	if( error == NULL )
+	{
+		return;
+	}
+	internal_error = (libcerror_internal_error_t *) error;
+
+	if( ( internal_error->creation_address != NULL )
+	 || ( internal_error->creation_callsite != NULL ) )
+	{
+		return;
+	}
+	internal_error->creation_address  = creation_address;
+	internal_error->creation_callsite = creation_callsite;
+}
+
+/* Prints the live errors to the stream set by libcerror_dump_live_errors_at_exit
+ */
+void libcerror_registry_dump_at_exit(
+      void )
+{
+	if( libcerror_registry_exit_stream != NULL )
+	{
+		libcerror_dump_live_errors(
+		 libcerror_registry_exit_stream );
+	}
+}
+
+/* Registers libcerror_registry_dump_at_exit to be called at exit
+ */
+void libcerror_registry_register_exit_function(
+      void )
+{
+	atexit(
+	 &libcerror_registry_dump_at_exit );
+}
+
+#endif /* defined( HAVE_ERROR_REGISTRY ) */
+
+/* Retrieves the number of live errors
+ * Returns 1 if successful, 0 if the live error registry is not available or -1 on error
+ */
+int libcerror_get_number_of_live_errors(
+     int *number_of_live_errors )
+{
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_registry_shard_t *shard = NULL;
+	int safe_number_of_live_errors    = 0;
+	int shard_index                   = 0;
+#endif
+
+	if( number_of_live_errors == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_REGISTRY )
+	if( pthread_once(
+	     &libcerror_registry_shards_once,
+	     &libcerror_registry_initialize_shards ) != 0 )
+	{
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBCERROR_REGISTRY_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		shard = &( libcerror_registry_shards[ shard_index ] );
+
+		if( pthread_mutex_lock(
+		     &( shard->mutex ) ) != 0 )
+		{
+			return( -1 );
+		}
+		safe_number_of_live_errors += shard->number_of_live_errors;
+
+		pthread_mutex_unlock(
+		 &( shard->mutex ) );
+	}
+	*number_of_live_errors = safe_number_of_live_errors;
+
+	return( 1 );
+#else
+	*number_of_live_errors = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_REGISTRY ) */
+}
+
+/* Prints the live errors to a stream
+ * An error is printed with its domain, code, depth, size and creation site,
+ * where the creation site is the file, line and function of a LIBCERROR_ERROR_SET_AT call site
+ * or the address of the code that called the function that created the error
+ * The messages are not printed since the errors can be modified by other threads
+ * Returns 1 if successful, 0 if the live error registry is not available or -1 on error
+ */
+int libcerror_dump_live_errors(
+     FILE *stream )
+{
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_internal_error_t *internal_error = NULL;
+	libcerror_registry_shard_t *shard          = NULL;
+	size_t arena_size                          = 0;
+	size_t total_arena_size                    = 0;
+	int number_of_live_errors                  = 0;
+	int print_count                            = 0;
+	int shard_index                            = 0;
+#endif
+
+	if( stream == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_REGISTRY )
+	if( pthread_once(
+	     &libcerror_registry_shards_once,
+	     &libcerror_registry_initialize_shards ) != 0 )
+	{
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBCERROR_REGISTRY_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		shard = &( libcerror_registry_shards[ shard_index ] );
+
+		if( pthread_mutex_lock(
+		     &( shard->mutex ) ) != 0 )
+		{
+			return( -1 );
+		}
+		for( internal_error = shard->first_live_error;
+		     internal_error != NULL;
+		     internal_error = internal_error->next_live_error )
+		{
+			if( libcerror_error_get_arena_size(
+			     internal_error->number_of_allocated_messages,
+			     internal_error->allocated_message_data_size,
+			     &arena_size ) != 1 )
+			{
+				arena_size = 0;
+			}
+			print_count = fprintf(
+			               stream,
+			               "Live error: %p, domain: %d, code: %d, depth: %d, size: %" PRIzu "\n",
+			               (void *) internal_error,
+			               internal_error->domain,
+			               internal_error->code,
+			               internal_error->number_of_messages,
+			               arena_size );
+
+			if( print_count > -1 )
+			{
+				if( internal_error->creation_callsite != NULL )
+				{
+					print_count = fprintf(
+					               stream,
+					               "\tcreated at: %s:%d in %s\n",
+					               internal_error->creation_callsite->file,
+					               internal_error->creation_callsite->line,
+					               internal_error->creation_callsite->function );
+				}
+				else if( internal_error->creation_address != NULL )
+				{
+					print_count = fprintf(
+					               stream,
+					               "\tcreated at: %p\n",
+					               internal_error->creation_address );
+				}
+			}
+			if( print_count <= -1 )
+			{
+				pthread_mutex_unlock(
+				 &( shard->mutex ) );
+
+				return( -1 );
+			}
+			number_of_live_errors += 1;
+			total_arena_size      += arena_size;
+		}
+		pthread_mutex_unlock(
+		 &( shard->mutex ) );
+	}
+	print_count = fprintf(
+	               stream,
+	               "Number of live errors: %d, size: %" PRIzu "\n",
+	               number_of_live_errors,
+	               total_arena_size );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_REGISTRY ) */
+}
+
+/* Prints the live errors to a stream when the program exits
+ * This can be used to report the errors that were not freed
+ * A stream of NULL disables the report
+ * Returns 1 if successful, 0 if the live error registry is not available or -1 on error
+ */
+int libcerror_dump_live_errors_at_exit(
+     FILE *stream LIBCERROR_ATTRIBUTE_UNUSED )
+{
+#if defined( HAVE_ERROR_REGISTRY )
+	libcerror_registry_exit_stream = stream;
+
+	if( stream == NULL )
+	{
+		return( 1 );
+	}
+	if( pthread_once(
+	     &libcerror_registry_exit_once,
+	     &libcerror_registry_register_exit_function ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+#else
+	LIBCERROR_UNREFERENCED_PARAMETER( stream )
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_REGISTRY ) */
+}
+
@@ -0,0 +1,90 @@
+/*
+ * Live error registry functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_REGISTRY_H )
+#define _LIBCERROR_REGISTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#include "libcerror_definitions.h"
+#include "libcerror_error.h"
+#include "libcerror_extern.h"
+#include "libcerror_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The address the current function returns to, used as the creation site of an error
+ */
+#if defined( __GNUC__ )
+#define LIBCERROR_REGISTRY_RETURN_ADDRESS \
+	__builtin_return_address( 0 )
+#else
+#define LIBCERROR_REGISTRY_RETURN_ADDRESS \
+	NULL
+#endif
+
+#if defined( HAVE_ERROR_REGISTRY )
+
+void libcerror_registry_initialize_shards(
+      void );
+
+void libcerror_registry_insert(
+      libcerror_internal_error_t *internal_error );
+
+void libcerror_registry_remove(
+      libcerror_internal_error_t *internal_error );
+
+void libcerror_registry_set_creation_site(
+      libcerror_error_t *error,
+      const void *creation_address,
+      libcerror_callsite_t *creation_callsite );
+
+void libcerror_registry_dump_at_exit(
+      void );
+
+void libcerror_registry_register_exit_function(
+      void );
+
+#endif /* defined( HAVE_ERROR_REGISTRY ) */
+
+LIBCERROR_EXTERN \
+int libcerror_get_number_of_live_errors(
+     int *number_of_live_errors );
+
+LIBCERROR_EXTERN \
+int libcerror_dump_live_errors(
+     FILE *stream );
+
+LIBCERROR_EXTERN \
+int libcerror_dump_live_errors_at_exit(
+     FILE *stream );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_REGISTRY_H ) */
+
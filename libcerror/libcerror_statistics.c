@@ -0,0 +1,680 @@
+/*
+ * Error statistics functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#include "libcerror_definitions.h"
+#include "libcerror_memory.h"
+#include "libcerror_statistics.h"
+#include "libcerror_unused.h"
+
+/* The names of the error domains in order of their domain index
+ * The last name is used for other domains
+ */
+static const char *libcerror_statistics_error_domain_names[ LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS + 1 ] = {
+	"arguments",
+	"conversion",
+	"compression",
+	"encryption",
+	"io",
+	"input",
+	"memory",
+	"output",
+	"runtime",
+	"other" };
+
+/* Retrieves the domain index of an error domain
+ * Returns the domain index or LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS for other domains
+ */
+int libcerror_statistics_get_domain_index(
+     int error_domain )
+{
+	switch( error_domain )
+	{
+		case LIBCERROR_ERROR_DOMAIN_ARGUMENTS:
+			return( 0 );
+
+		case LIBCERROR_ERROR_DOMAIN_CONVERSION:
+			return( 1 );
+
+		case LIBCERROR_ERROR_DOMAIN_COMPRESSION:
+			return( 2 );
+
+		case LIBCERROR_ERROR_DOMAIN_ENCRYPTION:
+			return( 3 );
+
+		case LIBCERROR_ERROR_DOMAIN_IO:
+			return( 4 );
+
+		case LIBCERROR_ERROR_DOMAIN_INPUT:
+			return( 5 );
+
+		case LIBCERROR_ERROR_DOMAIN_MEMORY:
+			return( 6 );
+
+		case LIBCERROR_ERROR_DOMAIN_OUTPUT:
+			return( 7 );
+
+		case LIBCERROR_ERROR_DOMAIN_RUNTIME:
+			return( 8 );
+
+		default:
+			break;
+	}
+	return( LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS );
+}
+
+/* Retrieves the name of an error domain
+ * Returns the name or "other" for other domains
+ */
+const char *libcerror_statistics_get_domain_name(
+             int error_domain )
+{
+	int domain_index = libcerror_statistics_get_domain_index(
+	                    error_domain );
+
+	return( libcerror_statistics_error_domain_names[ domain_index ] );
+}
+
+#if defined( HAVE_ERROR_STATISTICS )
+
+/* The error domains of the error statistics in order of their domain index
+ */
+static const int libcerror_statistics_error_domains[ LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS ] = {
+	LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	LIBCERROR_ERROR_DOMAIN_CONVERSION,
+	LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+	LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+	LIBCERROR_ERROR_DOMAIN_IO,
+	LIBCERROR_ERROR_DOMAIN_INPUT,
+	LIBCERROR_ERROR_DOMAIN_MEMORY,
+	LIBCERROR_ERROR_DOMAIN_OUTPUT,
+	LIBCERROR_ERROR_DOMAIN_RUNTIME };
+
+/* The error counters by domain index and code
+ * The last domain index and the last code are used for other domains and codes
+ * The counters are updated with relaxed atomic operations, hence they are not
+ * ordered with respect to each other
+ */
+static uint64_t libcerror_statistics_counters[ LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS + 1 ][ LIBCERROR_STATISTICS_NUMBER_OF_CODES + 1 ];
+
+/* The number of bytes allocated for message data
+ */
+static uint64_t libcerror_statistics_allocated_message_data_size = 0;
+
+/* The maximum number of messages of an error
+ */
+static int libcerror_statistics_maximum_depth                    = 0;
+
+/* The number of messages that were truncated to LIBCERROR_MESSAGE_MAXIMUM_SIZE
+ */
+static uint64_t libcerror_statistics_number_of_truncated_messages = 0;
+
+/* Increments the counter of an error domain and code
+ */
+void libcerror_statistics_increment(
+      int error_domain,
+      int error_code )
+{
+	int domain_index = libcerror_statistics_get_domain_index(
+	                    error_domain );
+
+	if( ( error_code < 0 )
+	 || ( error_code >= LIBCERROR_STATISTICS_NUMBER_OF_CODES ) )
+	{
+		error_code = LIBCERROR_STATISTICS_NUMBER_OF_CODES;
+	}
+	__atomic_fetch_add(
+	 &( libcerror_statistics_counters[ domain_index ][ error_code ] ),
+	 1,
+	 __ATOMIC_RELAXED );
+}
+
+/* Adds the size of newly allocated message data
+ */
+void libcerror_statistics_add_allocated_message_data_size(
+      size_t message_data_size )
+{
+	__atomic_fetch_add(
+	 &libcerror_statistics_allocated_message_data_size,
+	 (uint64_t) message_data_size,
+	 __ATOMIC_RELAXED );
+}
+
+/* Updates the maximum depth with the depth of an error
+ */
+void libcerror_statistics_update_maximum_depth(
+      int depth )
+{
+	int maximum_depth = __atomic_load_n(
+	                     &libcerror_statistics_maximum_depth,
+	                     __ATOMIC_RELAXED );
+
+	while( depth > maximum_depth )
+	{
+		if( __atomic_compare_exchange_n(
+		     &libcerror_statistics_maximum_depth,
+		     &maximum_depth,
+		     depth,
+		     0,
+		     __ATOMIC_RELAXED,
+		     __ATOMIC_RELAXED ) != 0 )
+		{
+			break;
+		}
+	}
+}
+
+/* Increments the number of truncated messages
+ */
+void libcerror_statistics_increment_truncated_messages(
+      void )
+{
+	__atomic_fetch_add(
+	 &libcerror_statistics_number_of_truncated_messages,
+	 1,
+	 __ATOMIC_RELAXED );
+}
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+
+/* Retrieves the number of times an error domain and code was set
+ * Other domains and codes can be retrieved with an error domain or error code of -1
+ * Returns 1 if successful, 0 if the statistics are not available or -1 on error
+ */
+int libcerror_statistics_get_count(
+     int error_domain LIBCERROR_ATTRIBUTE_UNUSED,
+     int error_code LIBCERROR_ATTRIBUTE_UNUSED,
+     uint64_t *count )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	int domain_index = 0;
+#endif
+
+	if( count == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	if( error_domain == -1 )
+	{
+		domain_index = LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS;
+	}
+	else
+	{
+		domain_index = libcerror_statistics_get_domain_index(
+		                error_domain );
+
+		if( domain_index == LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS )
+		{
+			return( -1 );
+		}
+	}
+	if( error_code == -1 )
+	{
+		error_code = LIBCERROR_STATISTICS_NUMBER_OF_CODES;
+	}
+	else if( ( error_code < 0 )
+	      || ( error_code >= LIBCERROR_STATISTICS_NUMBER_OF_CODES ) )
+	{
+		return( -1 );
+	}
+	*count = __atomic_load_n(
+	          &( libcerror_statistics_counters[ domain_index ][ error_code ] ),
+	          __ATOMIC_RELAXED );
+
+	return( 1 );
+#else
+	LIBCERROR_UNREFERENCED_PARAMETER( error_domain )
+	LIBCERROR_UNREFERENCED_PARAMETER( error_code )
+
+	*count = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Retrieves a snapshot of the error domains and codes that were set
+ * Only the counters that are not 0 are stored, other domains and codes have an error domain or error code of -1
+ * If the number of counters that are not 0 exceeds the maximum number of entries the remaining counters are not stored
+ * Since the counters are read one by one, the snapshot of one counter can be more recent than that of another
+ * Returns 1 if successful, 0 if the statistics are not available or -1 on error
+ */
+int libcerror_statistics_get_snapshot(
+     int *error_domains,
+     int *error_codes,
+     uint64_t *counts,
+     int maximum_number_of_entries,
+     int *number_of_entries )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	uint64_t count   = 0;
+	int domain_index = 0;
+	int entry_index  = 0;
+	int error_code   = 0;
+#endif
+
+	if( error_domains == NULL )
+	{
+		return( -1 );
+	}
+	if( error_codes == NULL )
+	{
+		return( -1 );
+	}
+	if( counts == NULL )
+	{
+		return( -1 );
+	}
+	if( maximum_number_of_entries < 0 )
+	{
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	for( domain_index = 0;
+	     domain_index <= LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS;
+	     domain_index++ )
+	{
+		for( error_code = 0;
+		     error_code <= LIBCERROR_STATISTICS_NUMBER_OF_CODES;
+		     error_code++ )
+		{
+			if( entry_index >= maximum_number_of_entries )
+			{
+				break;
+			}
+			count = __atomic_load_n(
+			         &( libcerror_statistics_counters[ domain_index ][ error_code ] ),
+			         __ATOMIC_RELAXED );
+
+			if( count == 0 )
+			{
+				continue;
+			}
+			if( domain_index < LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS )
+			{
+				error_domains[ entry_index ] = libcerror_statistics_error_domains[ domain_index ];
+			}
+			else
+			{
+				error_domains[ entry_index ] = -1;
+			}
+			if( error_code < LIBCERROR_STATISTICS_NUMBER_OF_CODES )
+			{
+				error_codes[ entry_index ] = error_code;
+			}
+			else
+			{
+				error_codes[ entry_index ] = -1;
+			}
+			counts[ entry_index ] = count;
+
+			entry_index++;
+		}
+	}
+	*number_of_entries = entry_index;
+
+	return( 1 );
+#else
+	*number_of_entries = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Retrieves the message statistics
+ * The allocated message data size is the number of bytes allocated for message data,
+ * the maximum depth the maximum number of messages of an error and the number of truncated messages
+ * the number of messages that were truncated to LIBCERROR_MESSAGE_MAXIMUM_SIZE
+ * Returns 1 if successful, 0 if the statistics are not available or -1 on error
+ */
+int libcerror_statistics_get_message_statistics(
+     uint64_t *allocated_message_data_size,
+     int *maximum_depth,
+     uint64_t *number_of_truncated_messages )
+{
+	if( allocated_message_data_size == NULL )
+	{
+		return( -1 );
+	}
+	if( maximum_depth == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_truncated_messages == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	*allocated_message_data_size = __atomic_load_n(
+	                                &libcerror_statistics_allocated_message_data_size,
+	                                __ATOMIC_RELAXED );
+
+	*maximum_depth = __atomic_load_n(
+	                  &libcerror_statistics_maximum_depth,
+	                  __ATOMIC_RELAXED );
+
+	*number_of_truncated_messages = __atomic_load_n(
+	                                 &libcerror_statistics_number_of_truncated_messages,
+	                                 __ATOMIC_RELAXED );
+
+	return( 1 );
+#else
+	*allocated_message_data_size  = 0;
+	*maximum_depth                = 0;
+	*number_of_truncated_messages = 0;
+
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Writes the error statistics to a stream in the Prometheus text exposition format
+ * Returns 1 if successful, 0 if the statistics are not available or -1 on error
+ */
+int libcerror_statistics_write_prometheus(
+     FILE *stream )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	uint64_t domain_counts[ LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS + 1 ];
+
+	uint64_t count   = 0;
+	int domain_index = 0;
+	int error_code   = 0;
+	int print_count  = 0;
+#endif
+
+	if( stream == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	print_count = fprintf(
+	               stream,
+	               "# HELP libcerror_errors_total Number of times an error was set by error domain and code.\n"
+	               "# TYPE libcerror_errors_total counter\n" );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	for( domain_index = 0;
+	     domain_index <= LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS;
+	     domain_index++ )
+	{
+		domain_counts[ domain_index ] = 0;
+
+		for( error_code = 0;
+		     error_code <= LIBCERROR_STATISTICS_NUMBER_OF_CODES;
+		     error_code++ )
+		{
+			count = __atomic_load_n(
+			         &( libcerror_statistics_counters[ domain_index ][ error_code ] ),
+			         __ATOMIC_RELAXED );
+
+			if( count == 0 )
+			{
+				continue;
+			}
+			domain_counts[ domain_index ] += count;
+
+			if( error_code < LIBCERROR_STATISTICS_NUMBER_OF_CODES )
+			{
+				print_count = fprintf(
+				               stream,
+				               "libcerror_errors_total{domain=\"%s\",code=\"%d\"} %" PRIu64 "\n",
+				               libcerror_statistics_error_domain_names[ domain_index ],
+				               error_code,
+				               count );
+			}
+			else
+			{
+				print_count = fprintf(
+				               stream,
+				               "libcerror_errors_total{domain=\"%s\",code=\"other\"} %" PRIu64 "\n",
+				               libcerror_statistics_error_domain_names[ domain_index ],
+				               count );
+			}
+			if( print_count <= -1 )
+			{
+				return( -1 );
+			}
+		}
+	}
+	print_count = fprintf(
+	               stream,
+	               "# HELP libcerror_domain_errors_total Number of times an error was set by error domain.\n"
+	               "# TYPE libcerror_domain_errors_total counter\n" );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	/* Every domain is written so that the time series do not appear and disappear
+	 */
+	for( domain_index = 0;
+	     domain_index <= LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS;
+	     domain_index++ )
+	{
+		print_count = fprintf(
+		               stream,
+		               "libcerror_domain_errors_total{domain=\"%s\"} %" PRIu64 "\n",
+		               libcerror_statistics_error_domain_names[ domain_index ],
+		               domain_counts[ domain_index ] );
+
+		if( print_count <= -1 )
+		{
+			return( -1 );
+		}
+	}
+	print_count = fprintf(
+	               stream,
+	               "# HELP libcerror_message_data_allocated_bytes_total Number of bytes allocated for message data.\n"
+	               "# TYPE libcerror_message_data_allocated_bytes_total counter\n"
+	               "libcerror_message_data_allocated_bytes_total %" PRIu64 "\n"
+	               "# HELP libcerror_error_maximum_depth Maximum number of messages of an error.\n"
+	               "# TYPE libcerror_error_maximum_depth gauge\n"
+	               "libcerror_error_maximum_depth %d\n"
+	               "# HELP libcerror_truncated_messages_total Number of messages truncated to the maximum message size.\n"
+	               "# TYPE libcerror_truncated_messages_total counter\n"
+	               "libcerror_truncated_messages_total %" PRIu64 "\n",
+	               __atomic_load_n(
+	                &libcerror_statistics_allocated_message_data_size,
+	                __ATOMIC_RELAXED ),
+	               __atomic_load_n(
+	                &libcerror_statistics_maximum_depth,
+	                __ATOMIC_RELAXED ),
+	               __atomic_load_n(
+	                &libcerror_statistics_number_of_truncated_messages,
+	                __ATOMIC_RELAXED ) );
+
+	if( print_count <= -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Writes the error statistics to a file in the Prometheus text exposition format
+ * The statistics are written to a temporary file named filename.tmp that is renamed afterwards,
+ * so that a textfile collector never reads a partially written file
+ * Returns 1 if successful, 0 if the statistics are not available or -1 on error
+ */
+int libcerror_statistics_write_prometheus_file(
+     const char *filename )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	FILE *stream                   = NULL;
+	char *temporary_filename       = NULL;
+	size_t filename_length         = 0;
+	size_t temporary_filename_size = 0;
+	int result                     = 0;
+#endif
+
+	if( filename == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_ERROR_STATISTICS )
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		return( -1 );
+	}
+	temporary_filename_size = filename_length + 5;
+
+	temporary_filename = (char *) libcerror_memory_allocate(
+	                               sizeof( char ) * temporary_filename_size );
+
+	if( temporary_filename == NULL )
+	{
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     temporary_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     &( temporary_filename[ filename_length ] ),
+	     ".tmp",
+	     5 ) == NULL )
+	{
+		goto on_error;
+	}
+	stream = fopen(
+	          temporary_filename,
+	          "w" );
+
+	if( stream == NULL )
+	{
+		goto on_error;
+	}
+	result = libcerror_statistics_write_prometheus(
+	          stream );
+
+	if( fclose(
+	     stream ) != 0 )
+	{
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		remove(
+		 temporary_filename );
+
+		goto on_error;
+	}
+#if defined( WINAPI )
+	/* On Windows rename fails if the file exists
+	 */
+	remove(
+	 filename );
+#endif
+	if( rename(
+	     temporary_filename,
+	     filename ) != 0 )
+	{
+		remove(
+		 temporary_filename );
+
+		goto on_error;
+	}
+	libcerror_memory_free(
+	 temporary_filename );
+
+	return( 1 );
+
+on_error:
+	libcerror_memory_free(
+	 temporary_filename );
+
+	return( -1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
+/* Resets the error statistics
+ * Returns 1 if successful, 0 if the statistics are not available or -1 on error
+ */
+int libcerror_statistics_reset(
+     void )
+{
+#if defined( HAVE_ERROR_STATISTICS )
+	int domain_index = 0;
+	int error_code   = 0;
+
+	for( domain_index = 0;
+	     domain_index <= LIBCERROR_STATISTICS_NUMBER_OF_DOMAINS;
+	     domain_index++ )
+	{
+		for( error_code = 0;
+		     error_code <= LIBCERROR_STATISTICS_NUMBER_OF_CODES;
+		     error_code++ )
+		{
+			__atomic_store_n(
+			 &( libcerror_statistics_counters[ domain_index ][ error_code ] ),
+			 0,
+			 __ATOMIC_RELAXED );
+		}
+	}
+	__atomic_store_n(
+	 &libcerror_statistics_allocated_message_data_size,
+	 0,
+	 __ATOMIC_RELAXED );
+
+	__atomic_store_n(
+	 &libcerror_statistics_maximum_depth,
+	 0,
+	 __ATOMIC_RELAXED );
+
+	__atomic_store_n(
+	 &libcerror_statistics_number_of_truncated_messages,
+	 0,
+	 __ATOMIC_RELAXED );
+
+	return( 1 );
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+}
+
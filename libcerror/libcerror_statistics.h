@@ -0,0 +1,97 @@
+/*
+ * Error statistics functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_STATISTICS_H )
+#define _LIBCERROR_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#include "libcerror_definitions.h"
+#include "libcerror_extern.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libcerror_statistics_get_domain_index(
+     int error_domain );
+
+const char *libcerror_statistics_get_domain_name(
+             int error_domain );
+
+#if defined( HAVE_ERROR_STATISTICS )
+
+void libcerror_statistics_increment(
+      int error_domain,
+      int error_code );
+
+void libcerror_statistics_add_allocated_message_data_size(
+      size_t message_data_size );
+
+void libcerror_statistics_update_maximum_depth(
+      int depth );
+
+void libcerror_statistics_increment_truncated_messages(
+      void );
+
+#endif /* defined( HAVE_ERROR_STATISTICS ) */
+
+LIBCERROR_EXTERN \
+int libcerror_statistics_get_count(
+     int error_domain,
+     int error_code,
+     uint64_t *count );
+
+LIBCERROR_EXTERN \
+int libcerror_statistics_get_snapshot(
+     int *error_domains,
+     int *error_codes,
+     uint64_t *counts,
+     int maximum_number_of_entries,
+     int *number_of_entries );
+
+LIBCERROR_EXTERN \
+int libcerror_statistics_get_message_statistics(
+     uint64_t *allocated_message_data_size,
+     int *maximum_depth,
+     uint64_t *number_of_truncated_messages );
+
+LIBCERROR_EXTERN \
+int libcerror_statistics_write_prometheus(
+     FILE *stream );
+
+LIBCERROR_EXTERN \
+int libcerror_statistics_write_prometheus_file(
+     const char *filename );
+
+LIBCERROR_EXTERN \
+int libcerror_statistics_reset(
+     void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_STATISTICS_H ) */
+
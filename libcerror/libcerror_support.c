@@ -25,6 +25,10 @@
 #include "libcerror_definitions.h"
 #include "libcerror_support.h"
 
+/* Value to indicate if the formatting of error messages is deferred
+ */
+int libcerror_deferred_formatting = 0;
+
 #if !defined( HAVE_LOCAL_LIBCERROR )
 
 /* Returns the library version as a string
@@ -37,3 +41,25 @@ const char *libcerror_get_version(
 
 #endif /* !defined( HAVE_LOCAL_LIBCERROR ) */
 
+/* Sets the deferred formatting mode
+ * In deferred formatting mode libcerror_error_set stores the format string and a copy
+ * of its arguments and the message is only formatted when the error is printed
+ * hence the format string must remain valid for the lifetime of the error, e.g. a string literal
+ * Format strings with conversion specifiers that cannot be deferred are formatted directly
+ * The mode applies to all threads and should be set before errors are created
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_set_deferred_formatting(
+     int deferred_formatting )
+{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( deferred_formatting != 0 )
+	{
+		return( -1 );
+	}
+#endif
+	libcerror_deferred_formatting = deferred_formatting;
+
+	return( 1 );
+}
+
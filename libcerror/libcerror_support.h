@@ -31,6 +31,9 @@
 extern "C" {
 #endif
 
+LIBCERROR_INTERNAL \
+int libcerror_deferred_formatting;
+
 #if !defined( HAVE_LOCAL_LIBCERROR )
 
 LIBCERROR_EXTERN \
@@ -39,6 +42,10 @@ const char *libcerror_get_version(
 
 #endif /* !defined( HAVE_LOCAL_LIBCERROR ) */
 
+LIBCERROR_EXTERN \
+int libcerror_set_deferred_formatting(
+     int deferred_formatting );
+
 #if defined( __cplusplus )
 }
 #endif
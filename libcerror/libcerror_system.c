@@ -44,6 +44,9 @@
 
 #include "libcerror_definitions.h"
 #include "libcerror_error.h"
+#include "libcerror_memory.h"
+#include "libcerror_registry.h"
+#include "libcerror_statistics.h"
 #include "libcerror_system.h"
 #include "libcerror_types.h"
 
@@ -338,50 +341,47 @@ int libcerror_system_copy_string_from_error_number(
 #error Missing error to string system function
 #endif
 
-#if defined( HAVE_STDARG_H ) || defined( WINAPI )
-#define VARARGS( function, error, error_domain, error_code, system_error_code, type, argument ) \
-        function( error, error_domain, error_code, system_error_code, type argument, ... )
-#define VASTART( argument_list, type, name ) \
-        va_start( argument_list, name )
-#define VAEND( argument_list ) \
-        va_end( argument_list )
+#if defined( va_copy )
+#define VACOPY( destination, source ) \
+        va_copy( destination, source )
 
-#elif defined( HAVE_VARARGS_H )
-#define VARARGS( function, error, error_domain, error_code, system_error_code, type, argument ) \
-        function( error, error_domain, error_code, system_error_code, va_alist ) va_dcl
-#define VASTART( argument_list, type, name ) \
-        { type name; va_start( argument_list ); name = va_arg( argument_list, type )
-#define VAEND( argument_list ) \
-        va_end( argument_list ); }
+#elif defined( __va_copy )
+#define VACOPY( destination, source ) \
+        __va_copy( destination, source )
 
-#endif
+#else
+#define VACOPY( destination, source ) \
+        ( destination ) = ( source )
 
-/* Sets an error and adds a system specific error string if possible
+#endif /* defined( va_copy ) */
+
+/* Sets an error with an argument list and adds a system specific error string if possible
  * Creates the error if necessary
  * The error domain and code are set only the first time and the error message is appended for back tracing
  */
-void VARARGS(
-      libcerror_system_set_error,
+void libcerror_system_vset_error(
       libcerror_error_t **error,
       int error_domain,
       int error_code,
       uint32_t system_error_code,
-      const char *,
-      format_string )
+      const char *format_string,
+      va_list argument_list )
 {
-	va_list argument_list;
+	va_list argument_list_copy;
 
 	libcerror_internal_error_t *internal_error = NULL;
 	system_character_t *error_string           = NULL;
 	system_character_t *system_format_string   = NULL;
-	void *reallocation                         = NULL;
 	size_t error_string_size                   = 0;
 	size_t format_string_length                = 0;
+	size_t message_data_offset                 = 0;
 	size_t message_size                        = 0;
 	size_t next_message_size                   = LIBCERROR_MESSAGE_INCREMENT_SIZE;
 	size_t string_index                        = 0;
+	int has_resize_error                       = 0;
 	int message_index                          = 0;
 	int print_count                            = 0;
+	int result                                 = 0;
 
 	if( error == NULL )
 	{
@@ -391,6 +391,11 @@ void VARARGS(
 	{
 		return;
 	}
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_increment(
+	 error_domain,
+	 error_code );
+#endif
 	format_string_length = narrow_string_length(
 	                        format_string );
 
@@ -414,16 +419,56 @@ void VARARGS(
 		     error_domain,
 		     error_code ) != 1 )
 		{
-			goto on_error;
+			/* Fall back to the reserve error so that the caller is informed
+			 * that there is insufficient memory
+			 */
+			if( libcerror_error_initialize_reserve(
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
 		}
 	}
+	else if( ( (libcerror_internal_error_t *) *error )->number_of_messages == 0 )
+	{
+		/* An error that was reset takes the domain and code of the first message
+		 */
+		( (libcerror_internal_error_t *) *error )->domain = error_domain;
+		( (libcerror_internal_error_t *) *error )->code   = error_code;
+	}
 	internal_error = (libcerror_internal_error_t *) *error;
 
-	if( libcerror_error_resize(
-	     internal_error ) != 1 )
+	/* The messages of the reserve error are formatted without allocating memory
+	 */
+	if( internal_error->is_reserve != 0 )
 	{
-		goto on_error;
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
+
+		libcerror_error_append_reserve_message(
+		 internal_error,
+		 system_format_string,
+		 argument_list_copy );
+
+		va_end(
+		 argument_list_copy );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcerror_memory_free(
+		 system_format_string );
+#endif
+		libcerror_error_notify_set(
+		 *error,
+		 error_domain,
+		 error_code,
+		 1,
+		 system_error_code );
+		return;
 	}
+	message_index       = internal_error->number_of_messages;
+	message_data_offset = internal_error->message_data_size;
+
 	if( format_string_length > next_message_size )
 	{
 		next_message_size = ( ( format_string_length / LIBCERROR_MESSAGE_INCREMENT_SIZE ) + 1 )
@@ -435,40 +480,49 @@ void VARARGS(
 		{
 			next_message_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
 		}
-		reallocation = memory_reallocate(
-		                error_string,
-		                sizeof( system_character_t ) * next_message_size );
-
-		if( reallocation == NULL )
+		/* The message string is formatted directly into the message data of the error
+		 */
+		if( libcerror_error_resize(
+		     &internal_error,
+		     message_index + 1,
+		     message_data_offset + next_message_size ) != 1 )
 		{
-			memory_free(
-			 error_string );
+			has_resize_error = 1;
 
 			goto on_error;
 		}
-		error_string = (system_character_t *) reallocation;
+		*error = (libcerror_error_t *) internal_error;
+
+		error_string = &( internal_error->message_data[ message_data_offset ] );
+
+		/* Format into all the available message data, so that in most cases
+		 * a single pass suffices, and otherwise the message string size is known
+		 */
+		message_size = internal_error->allocated_message_data_size - message_data_offset;
 
-		message_size = next_message_size;
+		if( message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+		{
+			message_size = LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+		}
 
 		/* argument_list cannot be reused in successive calls to vsnprintf
 		 */
-		VASTART(
-		 argument_list,
-		 const char *,
-		 format_string );
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
 
 		print_count = system_string_vsnprintf(
 		               error_string,
 		               message_size,
 		               system_format_string,
-		               argument_list );
+		               argument_list_copy );
 
-		VAEND(
-		 argument_list );
+		va_end(
+		 argument_list_copy );
 
 		if( print_count <= -1 )
 		{
-			next_message_size += LIBCERROR_MESSAGE_INCREMENT_SIZE;
+			next_message_size = message_size + LIBCERROR_MESSAGE_INCREMENT_SIZE;
 		}
 		else if( ( (size_t) print_count >= message_size )
 		      || ( error_string[ print_count ] != (system_character_t) 0 ) )
@@ -488,82 +542,190 @@ void VARARGS(
 	while( print_count <= -1 );
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	memory_free(
+	libcerror_memory_free(
 	 system_format_string );
 
 	system_format_string = NULL;
 #endif
 
-	if( message_size < LIBCERROR_MESSAGE_MAXIMUM_SIZE )
+	/* Truncate the message string if it does not fit in LIBCERROR_MESSAGE_MAXIMUM_SIZE
+	 */
+	if( print_count <= -1 )
+	{
+		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 4 ] = (system_character_t) '.';
+		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 3 ] = (system_character_t) '.';
+		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 2 ] = (system_character_t) '.';
+		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 1 ] = 0;
+		error_string_size                                  = (size_t) LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+
+#if defined( HAVE_ERROR_STATISTICS )
+		libcerror_statistics_increment_truncated_messages();
+#endif
+	}
+	else
 	{
 /* TODO move to separate helper function */
-		if( error_string != NULL )
+		string_index = error_string_size - 1;
+
+		if( ( string_index > 0 )
+		 && ( error_string[ string_index - 1 ] == (system_character_t) '.' ) )
 		{
-			string_index = error_string_size - 1;
+			string_index -= 1;
+		}
+		error_string[ string_index ] = 0;
+		error_string_size            = string_index + 1;
 
-			if( error_string[ string_index - 1 ] == (system_character_t) '.' )
-			{
-				string_index -= 1;
-			}
-			error_string[ string_index ] = 0;
-			error_string_size            = string_index + 1;
+		if( libcerror_error_resize(
+		     &internal_error,
+		     message_index + 1,
+		     message_data_offset + error_string_size + 13 + 512 ) == 1 )
+		{
+			*error = (libcerror_error_t *) internal_error;
 
-			reallocation = memory_reallocate(
-			                error_string,
-			                sizeof( system_character_t ) * ( message_size + 13 + 512 ) );
+			error_string = &( internal_error->message_data[ message_data_offset ] );
 
-			if( reallocation != NULL )
+			if( system_string_copy(
+			     &( error_string[ string_index ] ),
+			     _SYSTEM_STRING( " with error: " ),
+			     13 ) != NULL )
 			{
-				error_string = (system_character_t *) reallocation;
+				error_string_size += 13;
+				string_index      += 13;
+
+				print_count = libcerror_system_copy_string_from_error_number(
+					       &( error_string[ string_index ] ),
+					       512,
+					       system_error_code );
 
-				if( system_string_copy(
-				     &( error_string[ string_index ] ),
-				     _SYSTEM_STRING( " with error: " ),
-				     13 ) != NULL )
+				if( print_count != -1 )
 				{
-					error_string_size += 13;
-					string_index      += 13;
-
-					print_count = libcerror_system_copy_string_from_error_number(
-						       &( error_string[ string_index ] ),
-						       512,
-						       system_error_code );
-
-					if( print_count != -1 )
-					{
-						error_string_size += print_count;
-					}
+					error_string_size += print_count;
 				}
 			}
 		}
 	}
-	if( message_size >= LIBCERROR_MESSAGE_MAXIMUM_SIZE )
-	{
-		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 4 ] = (system_character_t) '.';
-		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 3 ] = (system_character_t) '.';
-		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 2 ] = (system_character_t) '.';
-		error_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 1 ] = 0;
-		error_string_size                                  = (size_t) LIBCERROR_MESSAGE_MAXIMUM_SIZE;
-	}
-	message_index = internal_error->number_of_messages - 1;
-
 	internal_error->messages[ message_index ] = error_string;
 	internal_error->sizes[ message_index ]    = error_string_size;
+	internal_error->flags[ message_index ]    = 0;
 
+	internal_error->number_of_messages += 1;
+	internal_error->message_data_size  += error_string_size;
+
+#if defined( HAVE_ERROR_STATISTICS )
+	libcerror_statistics_update_maximum_depth(
+	 internal_error->number_of_messages );
+#endif
+	libcerror_error_notify_set(
+	 *error,
+	 error_domain,
+	 error_code,
+	 1,
+	 system_error_code );
 	return;
 
 on_error:
+	/* If the error cannot be resized the message is formatted into the remaining message data
+	 * of the error, without the system error string, so that the message is truncated instead of lost
+	 */
+	if( has_resize_error != 0 )
+	{
+		VACOPY(
+		 argument_list_copy,
+		 argument_list );
+
+		result = libcerror_error_append_truncated_message(
+		          internal_error,
+		          system_format_string,
+		          argument_list_copy );
+
+		va_end(
+		 argument_list_copy );
+
+		if( result == 1 )
+		{
+#if defined( HAVE_ERROR_STATISTICS )
+			libcerror_statistics_increment_truncated_messages();
+#endif
+			libcerror_error_notify_set(
+			 *error,
+			 error_domain,
+			 error_code,
+			 1,
+			 system_error_code );
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( system_format_string != NULL )
 	{
-		memory_free(
+		libcerror_memory_free(
 		 system_format_string );
 	}
 #endif
 	return;
 }
 
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#define VARARGS( function, error, error_domain, error_code, system_error_code, type, argument ) \
+        function( error, error_domain, error_code, system_error_code, type argument, ... )
+#define VASTART( argument_list, type, name ) \
+        va_start( argument_list, name )
+#define VAEND( argument_list ) \
+        va_end( argument_list )
+
+#elif defined( HAVE_VARARGS_H )
+#define VARARGS( function, error, error_domain, error_code, system_error_code, type, argument ) \
+        function( error, error_domain, error_code, system_error_code, va_alist ) va_dcl
+#define VASTART( argument_list, type, name ) \
+        { type name; va_start( argument_list ); name = va_arg( argument_list, type )
+#define VAEND( argument_list ) \
+        va_end( argument_list ); }
+
+#endif
+
+/* Sets an error and adds a system specific error string if possible
+ * Creates the error if necessary
+ * The error domain and code are set only the first time and the error message is appended for back tracing
+ */
+void VARARGS(
+      libcerror_system_set_error,
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      uint32_t system_error_code,
+      const char *,
+      format_string )
+{
+	va_list argument_list;
+
+	VASTART(
+	 argument_list,
+	 const char *,
+	 format_string );
+
+	libcerror_system_vset_error(
+	 error,
+	 error_domain,
+	 error_code,
+	 system_error_code,
+	 format_string,
+	 argument_list );
+
+	VAEND(
+	 argument_list );
+
+#if defined( HAVE_ERROR_REGISTRY )
+	if( error != NULL )
+	{
+		libcerror_registry_set_creation_site(
+		 *error,
+		 LIBCERROR_REGISTRY_RETURN_ADDRESS,
+		 NULL );
+	}
+#endif
+}
+
 #undef VARARGS
 #undef VASTART
 #undef VAEND
+#undef VACOPY
 
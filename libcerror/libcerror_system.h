@@ -27,6 +27,14 @@
 
 #include <stdio.h>
 
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
 #include "libcerror_extern.h"
 #include "libcerror_types.h"
 
@@ -61,6 +69,15 @@ int libcerror_system_copy_string_from_error_number(
      size_t string_size,
      uint32_t error_number );
 
+LIBCERROR_EXTERN \
+void libcerror_system_vset_error(
+      libcerror_error_t **error,
+      int error_domain,
+      int error_code,
+      uint32_t system_error_code,
+      const char *format_string,
+      va_list argument_list );
+
 LIBCERROR_EXTERN \
 void libcerror_system_set_error(
       libcerror_error_t **error,
@@ -0,0 +1,94 @@
+/*
+ * Error trace functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libcerror_error.h"
+#include "libcerror_trace.h"
+#include "libcerror_types.h"
+
+/* The trace callback set by libcerror_set_trace_callback
+ */
+void (*libcerror_trace_callback)(
+       libcerror_error_t *error,
+       int error_domain,
+       int error_code,
+       uint32_t system_error_code,
+       int depth,
+       void *context ) = NULL;
+
+void *libcerror_trace_context = NULL;
+
+/* Invokes the trace callback for an error of which a message was just set
+ * The depth is the number of messages of the error
+ */
+void libcerror_trace_error(
+      libcerror_error_t *error,
+      int error_domain,
+      int error_code,
+      uint32_t system_error_code )
+{
+	if( ( libcerror_trace_callback == NULL )
+	 || ( error == NULL ) )
+	{
+		return;
+	}
+	libcerror_trace_callback(
+	 error,
+	 error_domain,
+	 error_code,
+	 system_error_code,
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 libcerror_trace_context );
+}
+
+/* Sets the trace callback
+ * The callback is invoked every time libcerror_error_set, libcerror_error_set_static or
+ * libcerror_system_set_error sets a message, with the error domain and code that were passed,
+ * the system error code or 0 and the depth of the error after the message was set
+ * The message is not formatted for the callback, the callback can retrieve it with libcerror_error_sprint
+ * The callback must not modify or free the error
+ * A callback of NULL removes the callback
+ * The callback applies to all threads and should be set before errors are created
+ * Returns 1 if successful or -1 on error
+ */
+int libcerror_set_trace_callback(
+     void (*callback)(
+            libcerror_error_t *error,
+            int error_domain,
+            int error_code,
+            uint32_t system_error_code,
+            int depth,
+            void *context ),
+     void *context )
+{
+	if( ( callback == NULL )
+	 && ( context != NULL ) )
+	{
+		return( -1 );
+	}
+	libcerror_trace_callback = callback;
+	libcerror_trace_context  = context;
+
+	return( 1 );
+}
+
@@ -0,0 +1,69 @@
+/*
+ * Error trace functions
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCERROR_TRACE_H )
+#define _LIBCERROR_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcerror_extern.h"
+#include "libcerror_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+LIBCERROR_INTERNAL \
+void (*libcerror_trace_callback)(
+       libcerror_error_t *error,
+       int error_domain,
+       int error_code,
+       uint32_t system_error_code,
+       int depth,
+       void *context );
+
+LIBCERROR_INTERNAL \
+void *libcerror_trace_context;
+
+void libcerror_trace_error(
+      libcerror_error_t *error,
+      int error_domain,
+      int error_code,
+      uint32_t system_error_code );
+
+LIBCERROR_EXTERN \
+int libcerror_set_trace_callback(
+     void (*callback)(
+            libcerror_error_t *error,
+            int error_domain,
+            int error_code,
+            uint32_t system_error_code,
+            int depth,
+            void *context ),
+     void *context );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCERROR_TRACE_H ) */
+
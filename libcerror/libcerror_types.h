@@ -35,6 +35,54 @@
  */
 typedef intptr_t libcerror_error_t;
 
+/* The call site descriptor of an error
+ * A descriptor is declared per call site by LIBCERROR_ERROR_SET_AT
+ */
+typedef struct libcerror_callsite libcerror_callsite_t;
+
+struct libcerror_callsite
+{
+	/* The error domain
+	 */
+	int error_domain;
+
+	/* The error code
+	 */
+	int error_code;
+
+	/* The format string, set when the call site is first hit
+	 */
+	const char *format_string;
+
+	/* The source file
+	 */
+	const char *file;
+
+	/* The source line
+	 */
+	int line;
+
+	/* The function
+	 */
+	const char *function;
+
+	/* The number of times the call site was hit
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of bytes of message data set by the call site
+	 */
+	uint64_t number_of_bytes;
+
+	/* The next registered call site
+	 */
+	libcerror_callsite_t *next_callsite;
+
+	/* Value to indicate the call site is registered
+	 */
+	int is_registered;
+};
+
 /* Currently not supported
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libcerror_error {}	libcerror_error_t;
@@ -0,0 +1,1006 @@
+/*
+ * Library error creation, propagation and printing benchmark program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <errno.h>
+
+#if defined( WINAPI )
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_unused.h"
+
+/* The default number of operations per benchmark
+ */
+#define CERROR_BENCH_DEFAULT_NUMBER_OF_OPERATIONS	100000
+
+/* The size of the string used by the backtrace print benchmarks
+ */
+#define CERROR_BENCH_STRING_SIZE			65536
+
+/* The maximum number of threads used by the stream contention benchmarks
+ */
+#define CERROR_BENCH_MAXIMUM_NUMBER_OF_THREADS		64
+
+typedef struct cerror_bench_memory_statistics cerror_bench_memory_statistics_t;
+typedef struct cerror_bench_thread_context cerror_bench_thread_context_t;
+
+/* The memory statistics
+ */
+struct cerror_bench_memory_statistics
+{
+	/* The number of allocations, including reallocations
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of allocated bytes, including reallocated bytes
+	 */
+	uint64_t number_of_allocated_bytes;
+};
+
+/* The context of a benchmark thread
+ */
+struct cerror_bench_thread_context
+{
+	/* The benchmark function
+	 */
+	int (*function)(
+	       int depth );
+
+	/* The depth
+	 */
+	int depth;
+
+	/* The number of operations
+	 */
+	int number_of_operations;
+
+	/* The result
+	 */
+	int result;
+};
+
+/* The memory statistics of the benchmarks
+ */
+static cerror_bench_memory_statistics_t cerror_bench_memory_statistics;
+
+/* The long message used by the formatted benchmarks
+ */
+static const char *cerror_bench_long_message = "Unable to read value from the file at the current offset since "
+                                               "the data does not contain a valid signature, the data is likely "
+                                               "corrupted or of an unsupported format version, or the file was truncated.";
+
+/* The string used by the backtrace print benchmarks
+ */
+static char cerror_bench_string[ CERROR_BENCH_STRING_SIZE ];
+
+/* The stream used by the backtrace print benchmarks
+ */
+static FILE *cerror_bench_stream = NULL;
+
+/* The error used by the backtrace print benchmarks
+ */
+static libcerror_error_t *cerror_bench_error = NULL;
+
+/* The stream shared by the threads of the stream contention benchmarks
+ */
+static FILE *cerror_bench_shared_stream = NULL;
+
+/* Benchmark memory allocate function
+ * Returns a pointer to the allocated memory or NULL on error
+ */
+void *cerror_bench_allocate(
+       size_t size,
+       void *context )
+{
+	cerror_bench_memory_statistics_t *statistics = (cerror_bench_memory_statistics_t *) context;
+
+	statistics->number_of_allocations     += 1;
+	statistics->number_of_allocated_bytes += size;
+
+	return( memory_allocate(
+	         size ) );
+}
+
+/* Benchmark memory reallocate function
+ * Returns a pointer to the reallocated memory or NULL on error
+ */
+void *cerror_bench_reallocate(
+       void *memory,
+       size_t size,
+       void *context )
+{
+	cerror_bench_memory_statistics_t *statistics = (cerror_bench_memory_statistics_t *) context;
+
+	statistics->number_of_allocations     += 1;
+	statistics->number_of_allocated_bytes += size;
+
+	return( memory_reallocate(
+	         memory,
+	         size ) );
+}
+
+/* Benchmark memory free function
+ */
+void cerror_bench_free(
+      void *memory,
+      void *context CERROR_TEST_ATTRIBUTE_UNUSED )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( context )
+
+	memory_free(
+	 memory );
+}
+
+/* Retrieves the current time in nano seconds
+ * Returns the time
+ */
+uint64_t cerror_bench_get_time(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	QueryPerformanceCounter(
+	 &counter );
+
+	QueryPerformanceFrequency(
+	 &frequency );
+
+	return( (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart ) );
+
+#elif defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+	clock_gettime(
+	 CLOCK_MONOTONIC,
+	 &time_value );
+
+	return( ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec );
+
+#else
+	return( (uint64_t) ( ( (double) clock() * 1000000000.0 ) / (double) CLOCKS_PER_SEC ) );
+
+#endif
+}
+
+/* Sets an error chain of a specific depth with a short message without format conversions
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_set_short(
+     int depth )
+{
+	libcerror_error_t *error = NULL;
+	int frame_index          = 0;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "Unable to read value." );
+	}
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+}
+
+/* Sets an error chain of a specific depth with a short message with format conversions
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_set_short_formatted(
+     int depth )
+{
+	libcerror_error_t *error = NULL;
+	int frame_index          = 0;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value: %d.",
+		 "cerror_bench_error_set_short_formatted",
+		 frame_index );
+	}
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+}
+
+/* Sets an error chain of a specific depth with a long message without format conversions
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_set_long(
+     int depth )
+{
+	libcerror_error_t *error = NULL;
+	int frame_index          = 0;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "Unable to read value from the file at the current offset since "
+		 "the data does not contain a valid signature, the data is likely "
+		 "corrupted or of an unsupported format version, or the file was truncated." );
+	}
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+}
+
+/* Sets an error chain of a specific depth with a long message with format conversions
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_set_long_formatted(
+     int depth )
+{
+	libcerror_error_t *error = NULL;
+	int frame_index          = 0;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: %s (frame: %d, offset: 0x%08" PRIx64 ").",
+		 "cerror_bench_error_set_long_formatted",
+		 cerror_bench_long_message,
+		 frame_index,
+		 (uint64_t) 0x12345678UL );
+	}
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+}
+
+/* Sets a system error chain of a specific depth with errno values
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_system_set_error(
+     int depth )
+{
+	static const uint32_t error_codes[ 4 ] = { EACCES, ENOENT, EINVAL, ENOMEM };
+
+	libcerror_error_t *error = NULL;
+	int frame_index          = 0;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_system_set_error(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 error_codes[ frame_index % 4 ],
+		 "%s: unable to open file: %d.",
+		 "cerror_bench_system_set_error",
+		 frame_index );
+	}
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+}
+
+/* Prints the back trace of the error to a string
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_backtrace_sprint(
+     int depth CERROR_TEST_ATTRIBUTE_UNUSED )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( depth )
+
+	if( libcerror_error_backtrace_sprint(
+	     cerror_bench_error,
+	     cerror_bench_string,
+	     CERROR_BENCH_STRING_SIZE ) <= -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints the back trace of the error to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_backtrace_fprint(
+     int depth CERROR_TEST_ATTRIBUTE_UNUSED )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( depth )
+
+	if( libcerror_error_backtrace_fprint(
+	     cerror_bench_error,
+	     cerror_bench_stream ) <= -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Backtrace visit callback that prints a frame with a separate fprintf call
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_fprint_frame(
+     int frame_index CERROR_TEST_ATTRIBUTE_UNUSED,
+     const char *message,
+     size_t message_size CERROR_TEST_ATTRIBUTE_UNUSED,
+     void *context )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( frame_index )
+	CERROR_TEST_UNREFERENCED_PARAMETER( message_size )
+
+	if( fprintf(
+	     (FILE *) context,
+	     "%s\n",
+	     message ) <= -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints the back trace of the error to the shared stream with a fprintf call per frame,
+ * which locks the stream for every frame
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_backtrace_fprint_per_frame(
+     int depth CERROR_TEST_ATTRIBUTE_UNUSED )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( depth )
+
+	if( libcerror_error_backtrace_visit(
+	     cerror_bench_error,
+	     &cerror_bench_fprint_frame,
+	     (void *) cerror_bench_shared_stream ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Prints the back trace of the error to the shared stream
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_error_backtrace_fprint_shared(
+     int depth CERROR_TEST_ATTRIBUTE_UNUSED )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( depth )
+
+	if( libcerror_error_backtrace_fprint(
+	     cerror_bench_error,
+	     cerror_bench_shared_stream ) <= -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Runs a benchmark and prints its results
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_run(
+     const char *name,
+     int (*function)(
+            int depth ),
+     int depth,
+     int number_of_operations )
+{
+	uint64_t end_time   = 0;
+	uint64_t start_time = 0;
+	int operation_index = 0;
+
+	if( number_of_operations < 1 )
+	{
+		number_of_operations = 1;
+	}
+	/* Warm up the caches and the error pool
+	 */
+	for( operation_index = 0;
+	     operation_index < 16;
+	     operation_index++ )
+	{
+		if( function(
+		     depth ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	cerror_bench_memory_statistics.number_of_allocations     = 0;
+	cerror_bench_memory_statistics.number_of_allocated_bytes = 0;
+
+	start_time = cerror_bench_get_time();
+
+	for( operation_index = 0;
+	     operation_index < number_of_operations;
+	     operation_index++ )
+	{
+		if( function(
+		     depth ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	end_time = cerror_bench_get_time();
+
+	fprintf(
+	 stdout,
+	 "%-32s %5d %12.1f %12.2f %12.1f\n",
+	 name,
+	 depth,
+	 (double) ( end_time - start_time ) / (double) number_of_operations,
+	 (double) cerror_bench_memory_statistics.number_of_allocations / (double) number_of_operations,
+	 (double) cerror_bench_memory_statistics.number_of_allocated_bytes / (double) number_of_operations );
+
+	return( 1 );
+}
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+
+/* Runs the operations of a benchmark thread
+ * Returns NULL
+ */
+void *cerror_bench_thread_run(
+       void *arguments )
+{
+	cerror_bench_thread_context_t *thread_context = (cerror_bench_thread_context_t *) arguments;
+	int operation_index                           = 0;
+
+	thread_context->result = 1;
+
+	for( operation_index = 0;
+	     operation_index < thread_context->number_of_operations;
+	     operation_index++ )
+	{
+		if( thread_context->function(
+		     thread_context->depth ) != 1 )
+		{
+			thread_context->result = -1;
+
+			break;
+		}
+	}
+	return( NULL );
+}
+
+/* Runs a benchmark in multiple threads concurrently and prints its results
+ * The time per operation is the elapsed time divided by the total number of operations
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_run_threads(
+     const char *name,
+     int (*function)(
+            int depth ),
+     int depth,
+     int number_of_threads,
+     int number_of_operations )
+{
+	cerror_bench_thread_context_t thread_contexts[ CERROR_BENCH_MAXIMUM_NUMBER_OF_THREADS ];
+	pthread_t threads[ CERROR_BENCH_MAXIMUM_NUMBER_OF_THREADS ];
+
+	uint64_t end_time             = 0;
+	uint64_t start_time           = 0;
+	int number_of_started_threads = 0;
+	int result                    = 1;
+	int thread_index              = 0;
+
+	if( ( number_of_threads < 1 )
+	 || ( number_of_threads > CERROR_BENCH_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		return( -1 );
+	}
+	if( number_of_operations < number_of_threads )
+	{
+		number_of_operations = number_of_threads;
+	}
+	start_time = cerror_bench_get_time();
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		thread_contexts[ thread_index ].function             = function;
+		thread_contexts[ thread_index ].depth                = depth;
+		thread_contexts[ thread_index ].number_of_operations = number_of_operations / number_of_threads;
+		thread_contexts[ thread_index ].result               = 0;
+
+		if( pthread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     &cerror_bench_thread_run,
+		     (void *) &( thread_contexts[ thread_index ] ) ) != 0 )
+		{
+			result = -1;
+
+			break;
+		}
+		number_of_started_threads++;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_started_threads;
+	     thread_index++ )
+	{
+		if( pthread_join(
+		     threads[ thread_index ],
+		     NULL ) != 0 )
+		{
+			result = -1;
+		}
+		else if( thread_contexts[ thread_index ].result != 1 )
+		{
+			result = -1;
+		}
+	}
+	end_time = cerror_bench_get_time();
+
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "%-32s %5d %7d %12.1f\n",
+	 name,
+	 depth,
+	 number_of_threads,
+	 (double) ( end_time - start_time ) / (double) ( ( number_of_operations / number_of_threads ) * number_of_threads ) );
+
+	return( 1 );
+}
+
+/* Runs the stream contention benchmarks for an error of a specific depth
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_run_stream_contention(
+     int depth,
+     int number_of_operations )
+{
+	static const int number_of_threads[ 4 ] = { 1, 4, 16, 64 };
+
+	int frame_index                         = 0;
+	int result                              = 1;
+	int threads_index                       = 0;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_error_set(
+		 &cerror_bench_error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value: %d.",
+		 "cerror_bench_run_stream_contention",
+		 frame_index );
+	}
+	if( cerror_bench_error == NULL )
+	{
+		return( -1 );
+	}
+	for( threads_index = 0;
+	     threads_index < 4;
+	     threads_index++ )
+	{
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( cerror_bench_run_threads(
+		     "fprint per frame",
+		     &cerror_bench_error_backtrace_fprint_per_frame,
+		     depth,
+		     number_of_threads[ threads_index ],
+		     number_of_operations ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+#endif
+		if( cerror_bench_run_threads(
+		     "libcerror_error_backtrace_fprint",
+		     &cerror_bench_error_backtrace_fprint_shared,
+		     depth,
+		     number_of_threads[ threads_index ],
+		     number_of_operations ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+	}
+	libcerror_error_free(
+	 &cerror_bench_error );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
+/* Runs the backtrace print benchmarks for an error of a specific depth
+ * Returns 1 if successful or -1 on error
+ */
+int cerror_bench_run_backtrace_print(
+     int depth,
+     int number_of_operations )
+{
+	int frame_index = 0;
+	int result      = 1;
+
+	for( frame_index = 0;
+	     frame_index < depth;
+	     frame_index++ )
+	{
+		libcerror_error_set(
+		 &cerror_bench_error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value: %d.",
+		 "cerror_bench_run_backtrace_print",
+		 frame_index );
+	}
+	if( cerror_bench_error == NULL )
+	{
+		return( -1 );
+	}
+	if( cerror_bench_run(
+	     "libcerror_error_backtrace_sprint",
+	     &cerror_bench_error_backtrace_sprint,
+	     depth,
+	     number_of_operations ) != 1 )
+	{
+		result = -1;
+	}
+	else if( cerror_bench_stream != NULL )
+	{
+		if( cerror_bench_run(
+		     "libcerror_error_backtrace_fprint",
+		     &cerror_bench_error_backtrace_fprint,
+		     depth,
+		     number_of_operations ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	libcerror_error_free(
+	 &cerror_bench_error );
+
+	return( result );
+}
+
+/* Prints the usage information
+ */
+void cerror_bench_usage_fprint(
+      FILE *stream )
+{
+	fprintf(
+	 stream,
+	 "Usage: cerror_bench [ -d ] [ -e ] [ -n number_of_operations ]\n\n" );
+
+	fprintf(
+	 stream,
+	 "\t-d: use deferred formatting of error messages\n" );
+
+	fprintf(
+	 stream,
+	 "\t-e: use stderr as the shared stream of the stream contention\n"
+	 "\t    benchmarks, stderr should be redirected, e.g. to /dev/null\n" );
+
+	fprintf(
+	 stream,
+	 "\t-n: number of operations per benchmark, default is %d\n",
+	 CERROR_BENCH_DEFAULT_NUMBER_OF_OPERATIONS );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	static const int depths[ 7 ] = { 1, 2, 4, 8, 16, 32, 64 };
+
+	int argument_index           = 0;
+	int depth_index              = 0;
+	int number_of_operations     = CERROR_BENCH_DEFAULT_NUMBER_OF_OPERATIONS;
+	int string_index             = 0;
+	int use_stderr               = 0;
+
+	for( argument_index = 1;
+	     argument_index < argc;
+	     argument_index++ )
+	{
+		if( system_string_compare(
+		     argv[ argument_index ],
+		     _SYSTEM_STRING( "-d" ),
+		     3 ) == 0 )
+		{
+			if( libcerror_set_deferred_formatting(
+			     1 ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Deferred formatting is not supported.\n" );
+
+				return( EXIT_FAILURE );
+			}
+		}
+		else if( system_string_compare(
+		          argv[ argument_index ],
+		          _SYSTEM_STRING( "-e" ),
+		          3 ) == 0 )
+		{
+			use_stderr = 1;
+		}
+		else if( ( system_string_compare(
+		            argv[ argument_index ],
+		            _SYSTEM_STRING( "-n" ),
+		            3 ) == 0 )
+		      && ( ( argument_index + 1 ) < argc ) )
+		{
+			argument_index++;
+
+			number_of_operations = 0;
+
+			for( string_index = 0;
+			     argv[ argument_index ][ string_index ] != 0;
+			     string_index++ )
+			{
+				if( ( argv[ argument_index ][ string_index ] < (system_character_t) '0' )
+				 || ( argv[ argument_index ][ string_index ] > (system_character_t) '9' )
+				 || ( number_of_operations > ( INT_MAX / 10 ) ) )
+				{
+					number_of_operations = 0;
+
+					break;
+				}
+				number_of_operations *= 10;
+				number_of_operations += (int) ( argv[ argument_index ][ string_index ] - (system_character_t) '0' );
+			}
+			if( number_of_operations <= 0 )
+			{
+				cerror_bench_usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+			}
+		}
+		else
+		{
+			cerror_bench_usage_fprint(
+			 stderr );
+
+			return( EXIT_FAILURE );
+		}
+	}
+	if( libcerror_set_memory_functions(
+	     &cerror_bench_allocate,
+	     &cerror_bench_reallocate,
+	     &cerror_bench_free,
+	     (void *) &cerror_bench_memory_statistics ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set memory functions.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( WINAPI )
+	cerror_bench_stream = file_stream_open(
+	                       "NUL",
+	                       FILE_STREAM_OPEN_WRITE );
+#else
+	cerror_bench_stream = file_stream_open(
+	                       "/dev/null",
+	                       FILE_STREAM_OPEN_WRITE );
+#endif
+	if( use_stderr != 0 )
+	{
+		cerror_bench_shared_stream = stderr;
+	}
+	else
+	{
+		cerror_bench_shared_stream = cerror_bench_stream;
+	}
+	fprintf(
+	 stdout,
+	 "%-32s %5s %12s %12s %12s\n",
+	 "benchmark",
+	 "depth",
+	 "ns/op",
+	 "allocs/op",
+	 "bytes/op" );
+
+	for( depth_index = 0;
+	     depth_index < 7;
+	     depth_index++ )
+	{
+		if( cerror_bench_run(
+		     "error_set short",
+		     &cerror_bench_error_set_short,
+		     depths[ depth_index ],
+		     number_of_operations / depths[ depth_index ] ) != 1 )
+		{
+			goto on_error;
+		}
+		if( cerror_bench_run(
+		     "error_set short formatted",
+		     &cerror_bench_error_set_short_formatted,
+		     depths[ depth_index ],
+		     number_of_operations / depths[ depth_index ] ) != 1 )
+		{
+			goto on_error;
+		}
+		if( cerror_bench_run(
+		     "error_set long",
+		     &cerror_bench_error_set_long,
+		     depths[ depth_index ],
+		     number_of_operations / depths[ depth_index ] ) != 1 )
+		{
+			goto on_error;
+		}
+		if( cerror_bench_run(
+		     "error_set long formatted",
+		     &cerror_bench_error_set_long_formatted,
+		     depths[ depth_index ],
+		     number_of_operations / depths[ depth_index ] ) != 1 )
+		{
+			goto on_error;
+		}
+		if( cerror_bench_run(
+		     "system_set_error",
+		     &cerror_bench_system_set_error,
+		     depths[ depth_index ],
+		     number_of_operations / depths[ depth_index ] ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	for( depth_index = 0;
+	     depth_index < 7;
+	     depth_index++ )
+	{
+		if( cerror_bench_run_backtrace_print(
+		     depths[ depth_index ],
+		     number_of_operations / depths[ depth_index ] ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	if( cerror_bench_shared_stream != NULL )
+	{
+		fprintf(
+		 stdout,
+		 "\n%-32s %5s %7s %12s\n",
+		 "stream contention benchmark",
+		 "depth",
+		 "threads",
+		 "ns/op" );
+
+		for( depth_index = 0;
+		     depth_index < 7;
+		     depth_index += 3 )
+		{
+			if( cerror_bench_run_stream_contention(
+			     depths[ depth_index ],
+			     number_of_operations / depths[ depth_index ] ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+	}
+#endif
+	if( cerror_bench_stream != NULL )
+	{
+		file_stream_close(
+		 cerror_bench_stream );
+	}
+	libcerror_set_memory_functions(
+	 NULL,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	fprintf(
+	 stderr,
+	 "Unable to run benchmark.\n" );
+
+	if( cerror_bench_stream != NULL )
+	{
+		file_stream_close(
+		 cerror_bench_stream );
+	}
+	libcerror_set_memory_functions(
+	 NULL,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,382 @@
+/*
+ * Library error call site functions test program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+/* Sets an error from the first test call site
+ */
+void cerror_test_callsite_set_first_error(
+      libcerror_error_t **error,
+      int value )
+{
+	LIBCERROR_ERROR_SET_AT(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 value );
+}
+
+/* Sets an error from the second test call site
+ */
+void cerror_test_callsite_set_second_error(
+      libcerror_error_t **error )
+{
+	LIBCERROR_ERROR_SET_AT(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error." );
+}
+
+/* Tests the libcerror_error_set_callsite function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_set_callsite(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	cerror_test_callsite_set_first_error(
+	 &error,
+	 1 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_IO_ERROR_READ_FAILED );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_free(
+	 &error );
+
+	cerror_test_callsite_set_second_error(
+	 &error );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	          LIBCERROR_RUNTIME_ERROR_GET_FAILED );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	libcerror_error_set_callsite(
+	 NULL,
+	 NULL,
+	 "Test error." );
+
+	libcerror_error_set_callsite(
+	 &error,
+	 NULL,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_callsite_get_hottest, libcerror_callsite_get_counts and libcerror_callsite_reset functions
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_callsite_get_hottest(
+     void )
+{
+	libcerror_callsite_t *callsites[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	uint64_t number_of_bytes = 0;
+	uint64_t number_of_hits  = 0;
+	int number_of_callsites  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_callsite_reset();
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	cerror_test_callsite_set_second_error(
+	 &error );
+
+	libcerror_error_free(
+	 &error );
+
+	cerror_test_callsite_set_first_error(
+	 &error,
+	 1 );
+
+	cerror_test_callsite_set_first_error(
+	 &error,
+	 2 );
+
+	cerror_test_callsite_set_first_error(
+	 &error,
+	 3 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_callsite_get_hottest(
+	          callsites,
+	          4,
+	          &number_of_callsites );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_callsites",
+		 number_of_callsites,
+		 2 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "callsites[ 0 ]->error_domain",
+		 callsites[ 0 ]->error_domain,
+		 LIBCERROR_ERROR_DOMAIN_IO );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "callsites[ 0 ]->error_code",
+		 callsites[ 0 ]->error_code,
+		 LIBCERROR_IO_ERROR_READ_FAILED );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "callsites[ 0 ]->format_string",
+		 callsites[ 0 ]->format_string );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "callsites[ 0 ]->file",
+		 callsites[ 0 ]->file );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "callsites[ 0 ]->function",
+		 callsites[ 0 ]->function );
+
+		CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+		 "callsites[ 0 ]->line",
+		 callsites[ 0 ]->line,
+		 0 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "callsites[ 1 ]->error_domain",
+		 callsites[ 1 ]->error_domain,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME );
+
+		result = libcerror_callsite_get_counts(
+		          callsites[ 0 ],
+		          &number_of_hits,
+		          &number_of_bytes );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_hits",
+		 number_of_hits,
+		 (uint64_t) 3 );
+
+		CERROR_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "number_of_bytes",
+		 (int64_t) number_of_bytes,
+		 (int64_t) 0 );
+
+		/* Test retrieving fewer call sites than there are hot call sites
+		 */
+		result = libcerror_callsite_get_hottest(
+		          callsites,
+		          1,
+		          &number_of_callsites );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_callsites",
+		 number_of_callsites,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "callsites[ 0 ]->error_domain",
+		 callsites[ 0 ]->error_domain,
+		 LIBCERROR_ERROR_DOMAIN_IO );
+
+		result = libcerror_callsite_reset();
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libcerror_callsite_get_hottest(
+		          callsites,
+		          4,
+		          &number_of_callsites );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_callsites",
+	 number_of_callsites,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libcerror_callsite_get_hottest(
+	          NULL,
+	          4,
+	          &number_of_callsites );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_callsite_get_hottest(
+	          callsites,
+	          -1,
+	          &number_of_callsites );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_callsite_get_hottest(
+	          callsites,
+	          4,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_callsite_get_counts(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_bytes );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_set_callsite",
+	 cerror_test_error_set_callsite );
+
+	CERROR_TEST_RUN(
+	 "libcerror_callsite_get_hottest",
+	 cerror_test_callsite_get_hottest );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
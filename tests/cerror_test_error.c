@@ -56,6 +56,7 @@
 
 #include "../libcerror/libcerror_definitions.h"
 #include "../libcerror/libcerror_error.h"
+#include "../libcerror/libcerror_pool.h"
 
 #if defined( HAVE_CERROR_TEST_FUNCTION_HOOK )
 
@@ -352,50 +353,63 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+#if defined( HAVE_STDARG_H )
 
-/* Tests the libcerror_error_free function
- * Returns 1 if successful or 0 if not
+/* Appends a message to the reserve error
+ * Returns 1 if successful, 0 if there is no room for the message or -1 on error
  */
-int cerror_test_error_free(
-     void )
+int cerror_test_error_append_reserve_message(
+     libcerror_error_t *error,
+     const char *format_string,
+     ... )
 {
-	/* Test error cases
-	 */
-	libcerror_error_free(
-	 NULL );
+	va_list argument_list;
 
-	return( 1 );
+	int result = 0;
+
+	va_start(
+	 argument_list,
+	 format_string );
+
+	result = libcerror_error_append_reserve_message(
+	          (libcerror_internal_error_t *) error,
+	          (const system_character_t *) format_string,
+	          argument_list );
+
+	va_end(
+	 argument_list );
+
+	return( result );
 }
 
-#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+#endif /* defined( HAVE_STDARG_H ) */
 
-/* Tests the libcerror_error_resize function
+/* Tests the libcerror_error_initialize_reserve function
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_resize(
+int cerror_test_error_initialize_reserve(
      void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error                   = NULL;
+	int result                                 = 0;
 
-	/* Initialize test
-	 */
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
+#if defined( LIBCERROR_THREAD_LOCAL )
+	libcerror_error_t *second_error            = NULL;
+	libcerror_internal_error_t *internal_error = NULL;
+#endif
+#if defined( LIBCERROR_THREAD_LOCAL ) && defined( HAVE_STDARG_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	char message_string[ 64 ];
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	size_t message_data_size                   = 0;
+	int message_index                          = 0;
+#endif
 
-	/* Test libcerror_error_resize
+	/* Test regular cases
 	 */
-	result = libcerror_error_resize(
-	          (libcerror_internal_error_t *) error );
+	result = libcerror_error_initialize_reserve(
+	          &error );
 
+#if defined( LIBCERROR_THREAD_LOCAL )
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -405,100 +419,186 @@ int cerror_test_error_resize(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libcerror_error_resize(
-	          NULL );
+	internal_error = (libcerror_internal_error_t *) error;
+
+	result = libcerror_error_is_reserve(
+	          internal_error );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-#if defined( HAVE_CERROR_TEST_MEMORY )
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_MEMORY,
+	          LIBCERROR_MEMORY_ERROR_INSUFFICIENT );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* Test libcerror_error_resize with libcerror_error_initialize failing
+	/* There is a single reserve error per thread
 	 */
-	cerror_test_malloc_attempts_before_fail = 0;
+	result = libcerror_error_initialize_reserve(
+	          &second_error );
 
-	result = libcerror_error_resize(
-	          (libcerror_internal_error_t *) error );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	if( cerror_test_malloc_attempts_before_fail != -1 )
-	{
-		cerror_test_malloc_attempts_before_fail = -1;
-	}
-	else
-	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "second_error",
+	 second_error );
 
-		CERROR_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	/* Test libcerror_error_resize with realloc failing
+	/* The reserve error cannot be reallocated
 	 */
 	result = libcerror_error_resize(
-	          (libcerror_internal_error_t *) error );
+	          &internal_error,
+	          internal_error->number_of_allocated_messages + 1,
+	          internal_error->allocated_message_data_size );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	cerror_test_realloc_attempts_before_fail = 0;
+#if defined( HAVE_STDARG_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = cerror_test_error_append_reserve_message(
+	          error,
+	          "Test error %d.",
+	          1 );
 
-	result = libcerror_error_resize(
-	          (libcerror_internal_error_t *) error );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	if( cerror_test_realloc_attempts_before_fail != -1 )
-	{
-		cerror_test_realloc_attempts_before_fail = -1;
-	}
-	else
-	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "sizes[ 0 ]",
+	 internal_error->sizes[ 0 ],
+	 (size_t) 14 );
 
-		CERROR_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-	}
-	cerror_test_realloc_attempts_before_fail = 1;
+	/* A message that does not fit in the remaining message data is truncated
+	 */
+	memory_set(
+	 message_string,
+	 'A',
+	 63 );
 
-	result = libcerror_error_resize(
-	          (libcerror_internal_error_t *) error );
+	message_string[ 63 ] = 0;
 
-	if( cerror_test_realloc_attempts_before_fail != -1 )
+	for( message_index = 1;
+	     message_index < internal_error->number_of_allocated_messages;
+	     message_index++ )
 	{
-		cerror_test_realloc_attempts_before_fail = -1;
+		result = cerror_test_error_append_reserve_message(
+		          error,
+		          "%s%s%s%s",
+		          message_string,
+		          message_string,
+		          message_string,
+		          message_string );
+
+		if( result != 1 )
+		{
+			break;
+		}
 	}
-	else
-	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-		CERROR_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-	}
-#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+	/* The last message was truncated to the remaining message data
+	 */
+	message_index     = internal_error->number_of_messages - 1;
+	message_data_size = internal_error->sizes[ message_index ];
 
-	/* Clean up
+	CERROR_TEST_ASSERT_LESS_THAN_INT(
+	 "message_data_size",
+	 (int) message_data_size,
+	 253 );
+
+	result = narrow_string_compare(
+	          &( internal_error->messages[ message_index ][ message_data_size - 4 ] ),
+	          "...",
+	          4 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* No room for more messages
+	 */
+	result = cerror_test_error_append_reserve_message(
+	          error,
+	          "Test error." );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+#endif /* defined( HAVE_STDARG_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	/* The reserve error can be reused after it was freed
 	 */
 	libcerror_error_free(
-	  &error );
+	 &error );
 
 	CERROR_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	result = libcerror_error_initialize_reserve(
+	          &error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_messages",
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 0 );
+
+	libcerror_error_free(
+	 &error );
+#else
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+#endif /* defined( LIBCERROR_THREAD_LOCAL ) */
+
+	/* Test error cases
+	 */
+	result = libcerror_error_initialize_reserve(
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	error = (libcerror_error_t *) 0x12345678;
+
+	result = libcerror_error_initialize_reserve(
+	          &error );
+
+	error = NULL;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
 	return( 1 );
 
 on_error:
@@ -510,136 +610,189 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
 
-/* Tests the libcerror_error_get_system_format_string function
+/* Tests the libcerror_error_free function
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_get_system_format_string(
+int cerror_test_error_free(
      void )
 {
-	system_character_t *format_string = NULL;
-
-	/* Test cerror_test_error_get_system_format_string
-	 */
-	libcerror_error_get_system_format_string(
-	 "Test error.",
-	 12,
-	 &format_string );
-
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "format_string",
-	 format_string );
-
-	format_string = NULL;
-
 	/* Test error cases
 	 */
-	libcerror_error_get_system_format_string(
-	 NULL,
-	 12,
-	 &format_string );
-
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "format_string",
-	 format_string );
-
-	libcerror_error_get_system_format_string(
-	 "Test error.",
-	 (size_t) SSIZE_MAX + 1,
-	 &format_string );
-
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "format_string",
-	 format_string );
-
-	libcerror_error_get_system_format_string(
-	 "Test error.",
-	 12,
+	libcerror_error_free(
 	 NULL );
 
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "format_string",
-	 format_string );
-
 	return( 1 );
-
-on_error:
-	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
-
-#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
-
-/* Tests the libcerror_error_set function
+/* Tests the libcerror_error_reset function
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_set(
+int cerror_test_error_reset(
      void )
 {
-	libcerror_error_t *error = NULL;
+	libcerror_error_t *error       = NULL;
+	libcerror_error_t *reset_error = NULL;
+	int error_index                = 0;
+	int result                     = 0;
 
-	/* Test libcerror_error_set
+	/* Initialize test
 	 */
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
-
+	for( error_index = 0;
+	     error_index < 8;
+	     error_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error %d.",
+		 error_index );
+	}
 	CERROR_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	  &error );
-
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	/* Test regular cases
+	 */
+	result = libcerror_error_reset(
+	          error );
 
-	/* Test libcerror_error_set with format string larger than LIBCERROR_MESSAGE_INCREMENT_SIZE
-	 */
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "The aim of science is not to open the door to infinite wisdom, but to set a limit to infinite error." );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	          LIBCERROR_RUNTIME_ERROR_GENERIC );
 
-	libcerror_error_free(
-	  &error );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_messages",
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 0 );
 
-	/* Test libcerror_error_set with parameters
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "message_data_size",
+	 ( (libcerror_internal_error_t *) error )->message_data_size,
+	 (size_t) 0 );
+#endif
+
+	/* The error takes the domain and code of the next error set
+	 * and reuses its allocated memory
 	 */
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error with parameter: %s = %d.",
-	 "MYPARAMETER",
-	 5 );
+	reset_error = error;
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+#if defined( HAVE_CERROR_TEST_MEMORY )
+	cerror_test_malloc_attempts_before_fail  = 0;
+	cerror_test_realloc_attempts_before_fail = 0;
+#endif
+
+	for( error_index = 0;
+	     error_index < 8;
+	     error_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "Test error %d.",
+		 error_index );
+	}
+#if defined( HAVE_CERROR_TEST_MEMORY )
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_malloc_attempts_before_fail",
+	 cerror_test_malloc_attempts_before_fail,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_realloc_attempts_before_fail",
+	 cerror_test_realloc_attempts_before_fail,
+	 0 );
+
+	cerror_test_malloc_attempts_before_fail  = -1;
+	cerror_test_realloc_attempts_before_fail = -1;
+#endif
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "error == reset_error",
+	 (int) ( error == reset_error ),
+	 1 );
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_IO_ERROR_READ_FAILED );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_messages",
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 8 );
+#endif
 
+	/* Clean up
+	 */
 	libcerror_error_free(
-	  &error );
+	 &error );
 
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	/* Test error cases
+	 */
+	result = libcerror_error_reset(
+	          NULL );
 
-	/* Test libcerror_error_set multiple times
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_CERROR_TEST_MEMORY )
+	cerror_test_malloc_attempts_before_fail  = -1;
+	cerror_test_realloc_attempts_before_fail = -1;
+#endif
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+/* Tests the libcerror_error_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_resize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libcerror_internal_error_t *internal_error = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_CERROR_TEST_MEMORY )
+	char long_string[ 2048 ];
+
+	int message_index                          = 0;
+	int number_of_reallocations                = 0;
+#endif
+
+	/* Initialize test
 	 */
 	libcerror_error_set(
 	 &error,
@@ -651,85 +804,133 @@ int cerror_test_error_set(
 	 "error",
 	 error );
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 2." );
+	/* Test libcerror_error_resize
+	 */
+	internal_error = (libcerror_internal_error_t *) error;
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	result = libcerror_error_resize(
+	          &internal_error,
+	          8,
+	          1024 );
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 3." );
+	error = (libcerror_error_t *) internal_error;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	CERROR_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	  &error );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->number_of_messages",
+	 internal_error->number_of_messages,
+	 1 );
 
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->number_of_allocated_messages",
+	 internal_error->number_of_allocated_messages,
+	 8 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_error->allocated_message_data_size",
+	 internal_error->allocated_message_data_size,
+	 (size_t) 1024 );
+
+	/* Test if the message strings were relocated
+	 */
+	result = system_string_compare(
+	          internal_error->messages[ 0 ],
+	          _SYSTEM_STRING( "Test error 1." ),
+	          14 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	/* Test error cases
 	 */
-	libcerror_error_set(
-	 NULL,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
+	result = libcerror_error_resize(
+	          NULL,
+	          8,
+	          1024 );
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 NULL );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	result = libcerror_error_resize(
+	          &internal_error,
+	          -1,
+	          1024 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_resize(
+	          &internal_error,
+	          8,
+	          (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE + 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 #if defined( HAVE_CERROR_TEST_MEMORY )
 
-	/* Test libcerror_error_set with libcerror_error_initialize failing
+	/* Test libcerror_error_resize with realloc failing
 	 */
-	cerror_test_malloc_attempts_before_fail = 0;
+	cerror_test_realloc_attempts_before_fail = 0;
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
+	result = libcerror_error_resize(
+	          &internal_error,
+	          16,
+	          2048 );
 
-	if( cerror_test_malloc_attempts_before_fail != -1 )
+	if( cerror_test_realloc_attempts_before_fail != -1 )
 	{
-		cerror_test_malloc_attempts_before_fail = -1;
+		cerror_test_realloc_attempts_before_fail = -1;
+
+		error = (libcerror_error_t *) internal_error;
 	}
 	else
 	{
-		CERROR_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	libcerror_error_free(
-	  &error );
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
-	/* Test libcerror_error_set with libcerror_error_resize failing
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "internal_error->number_of_allocated_messages",
+		 internal_error->number_of_allocated_messages,
+		 8 );
+	}
+	/* Test if a message is truncated into the remaining message data if the error cannot be resized
 	 */
+	memory_set(
+	 long_string,
+	 'A',
+	 2047 );
+
+	long_string[ 2047 ] = 0;
+
 	cerror_test_realloc_attempts_before_fail = 0;
 
 	libcerror_error_set(
 	 &error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
+	 "%s",
+	 long_string );
+
+	internal_error = (libcerror_internal_error_t *) error;
 
 	if( cerror_test_realloc_attempts_before_fail != -1 )
 	{
@@ -737,14 +938,2530 @@ int cerror_test_error_set(
 	}
 	else
 	{
-		CERROR_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "internal_error->number_of_messages",
+		 internal_error->number_of_messages,
+		 2 );
+
+		CERROR_TEST_ASSERT_EQUAL_SIZE(
+		 "internal_error->sizes[ 1 ]",
+		 internal_error->sizes[ 1 ],
+		 (size_t) ( 1024 - 14 ) );
+
+		result = system_string_compare(
+		          &( internal_error->messages[ 1 ][ 1024 - 18 ] ),
+		          _SYSTEM_STRING( "..." ),
+		          4 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test if the message is not set if there is no remaining message data
+		 */
+		cerror_test_realloc_attempts_before_fail = 0;
+
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error %d.",
+		 2 );
+
+		cerror_test_realloc_attempts_before_fail = -1;
+
+		internal_error = (libcerror_internal_error_t *) error;
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "internal_error->number_of_messages",
+		 internal_error->number_of_messages,
+		 2 );
+
+		result = system_string_compare(
+		          internal_error->messages[ 0 ],
+		          _SYSTEM_STRING( "Test error 1." ),
+		          14 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		CERROR_TEST_ASSERT_EQUAL_SIZE(
+		 "internal_error->sizes[ 1 ]",
+		 internal_error->sizes[ 1 ],
+		 (size_t) ( 1024 - 14 ) );
 	}
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
 	libcerror_error_free(
 	  &error );
 
-	/* Test libcerror_error_set with memory_reallocate before system_string_vsnprintf failing
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_CERROR_TEST_MEMORY )
+
+	/* Test if the number of reallocations is logarithmic in the number of messages
+	 */
+	cerror_test_realloc_attempts_before_fail = 1024;
+
+	for( message_index = 0;
+	     message_index < 64;
+	     message_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error %d.",
+		 message_index );
+	}
+	number_of_reallocations = 1024 - cerror_test_realloc_attempts_before_fail;
+
+	cerror_test_realloc_attempts_before_fail = -1;
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->number_of_messages",
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 64 );
+
+	/* 64 messages of 15 characters require at most 4 reallocations of the number of messages
+	 * and 3 reallocations of the message data
+	 */
+	CERROR_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_reallocations",
+	 number_of_reallocations,
+	 8 );
+
+	result = system_string_compare(
+	          ( (libcerror_internal_error_t *) error )->messages[ 0 ],
+	          _SYSTEM_STRING( "Test error 0." ),
+	          14 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = system_string_compare(
+	          ( (libcerror_internal_error_t *) error )->messages[ 63 ],
+	          _SYSTEM_STRING( "Test error 63." ),
+	          15 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	libcerror_error_free(
+	  &error );
+
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Tests the libcerror_error_get_system_format_string function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_get_system_format_string(
+     void )
+{
+	system_character_t *format_string = NULL;
+
+	/* Test cerror_test_error_get_system_format_string
+	 */
+	libcerror_error_get_system_format_string(
+	 "Test error.",
+	 12,
+	 &format_string );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "format_string",
+	 format_string );
+
+	format_string = NULL;
+
+	/* Test error cases
+	 */
+	libcerror_error_get_system_format_string(
+	 NULL,
+	 12,
+	 &format_string );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "format_string",
+	 format_string );
+
+	libcerror_error_get_system_format_string(
+	 "Test error.",
+	 (size_t) SSIZE_MAX + 1,
+	 &format_string );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "format_string",
+	 format_string );
+
+	libcerror_error_get_system_format_string(
+	 "Test error.",
+	 12,
+	 NULL );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "format_string",
+	 format_string );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+
+/* Tests the libcerror_error_set function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_set(
+     void )
+{
+	libcerror_error_t *error = NULL;
+
+#if defined( HAVE_CERROR_TEST_MEMORY ) && defined( LIBCERROR_THREAD_LOCAL )
+	int result               = 0;
+#endif
+
+#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK )
+	int number_of_passes     = 0;
+#endif
+
+	/* Test libcerror_error_set
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libcerror_error_set with format string larger than LIBCERROR_MESSAGE_INCREMENT_SIZE
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "The aim of science is not to open the door to infinite wisdom, but to set a limit to infinite error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libcerror_error_set with parameters
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error with parameter: %s = %d.",
+	 "MYPARAMETER",
+	 5 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libcerror_error_set multiple times
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 3." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	libcerror_error_set(
+	 NULL,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 NULL );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_CERROR_TEST_MEMORY )
+
+	/* Test libcerror_error_set with libcerror_error_initialize failing
+	 * which falls back to the reserve error
+	 */
+	libcerror_pool_flush();
+
+	cerror_test_malloc_attempts_before_fail = 0;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 1 );
+
+	if( cerror_test_malloc_attempts_before_fail != -1 )
+	{
+		cerror_test_malloc_attempts_before_fail = -1;
+	}
+	else
+	{
+#if defined( LIBCERROR_THREAD_LOCAL )
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		result = libcerror_error_matches(
+		          error,
+		          LIBCERROR_ERROR_DOMAIN_MEMORY,
+		          LIBCERROR_MEMORY_ERROR_INSUFFICIENT );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		/* The messages of the reserve error do not require memory allocation
+		 */
+		cerror_test_malloc_attempts_before_fail  = 0;
+		cerror_test_realloc_attempts_before_fail = 0;
+
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error %d.",
+		 2 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "cerror_test_malloc_attempts_before_fail",
+		 cerror_test_malloc_attempts_before_fail,
+		 0 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "cerror_test_realloc_attempts_before_fail",
+		 cerror_test_realloc_attempts_before_fail,
+		 0 );
+
+		cerror_test_malloc_attempts_before_fail  = -1;
+		cerror_test_realloc_attempts_before_fail = -1;
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_messages",
+		 ( (libcerror_internal_error_t *) error )->number_of_messages,
+		 2 );
+
+		result = narrow_string_compare(
+		          ( (libcerror_internal_error_t *) error )->messages[ 1 ],
+		          "Test error 2.",
+		          14 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+#else
+		CERROR_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+#endif /* defined( LIBCERROR_THREAD_LOCAL ) */
+	}
+	libcerror_error_free(
+	  &error );
+
+	/* Test libcerror_error_set with libcerror_error_resize failing
+	 */
+	cerror_test_realloc_attempts_before_fail = 0;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error." );
+
+	if( cerror_test_realloc_attempts_before_fail != -1 )
+	{
+		cerror_test_realloc_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+	}
+	libcerror_error_free(
+	  &error );
+
+	/* Test libcerror_error_set with memory_reallocate before system_string_vsnprintf failing
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	cerror_test_realloc_attempts_before_fail = 2;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
+
+	if( cerror_test_realloc_attempts_before_fail != -1 )
+	{
+		cerror_test_realloc_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+	}
+	libcerror_error_free(
+	  &error );
+
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+
+	/* TODO test libcerror_error_get_system_format_string failing */
+
+#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK )
+
+	/* Test if libcerror_error_set formats a message string that exceeds
+	 * LIBCERROR_MESSAGE_INCREMENT_SIZE in a single pass
+	 */
+	cerror_test_vsnprintf_attempts_before_fail = 16;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "%s: unable to read %s at offset: %d (0x%08x).",
+	 "libcerror_test_function",
+	 "The aim of science is not to open the door to infinite wisdom, but to set a limit to infinite error.",
+	 1024,
+	 1024 );
+
+	number_of_passes = 16 - cerror_test_vsnprintf_attempts_before_fail;
+
+	cerror_test_vsnprintf_attempts_before_fail = -1;
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	CERROR_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_passes",
+	 number_of_passes,
+	 2 );
+
+	/* Test if libcerror_error_set formats a message string that exceeds
+	 * the available message data in two passes
+	 */
+	cerror_test_vsnprintf_attempts_before_fail = 16;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "%s %s %s",
+	 "The aim of science is not to open the door to infinite wisdom, but to set a limit to infinite error.",
+	 "The aim of science is not to open the door to infinite wisdom, but to set a limit to infinite error.",
+	 "The aim of science is not to open the door to infinite wisdom, but to set a limit to infinite error." );
+
+	number_of_passes = 16 - cerror_test_vsnprintf_attempts_before_fail;
+
+	cerror_test_vsnprintf_attempts_before_fail = -1;
+
+	CERROR_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_passes",
+	 number_of_passes,
+	 3 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->number_of_messages",
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 2 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_error->sizes[ 1 ]",
+	 ( (libcerror_internal_error_t *) error )->sizes[ 1 ],
+	 (size_t) 303 );
+
+	libcerror_error_free(
+	  &error );
+
+	/* Test if libcerror_error_set does not format a message string
+	 * without conversion specifiers
+	 */
+	cerror_test_vsnprintf_attempts_before_fail = 16;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Unable to read header." );
+
+	number_of_passes = 16 - cerror_test_vsnprintf_attempts_before_fail;
+
+	cerror_test_vsnprintf_attempts_before_fail = -1;
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_passes",
+	 number_of_passes,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_error->sizes[ 0 ]",
+	 ( (libcerror_internal_error_t *) error )->sizes[ 0 ],
+	 (size_t) 23 );
+
+	libcerror_error_free(
+	  &error );
+
+	/* Test libcerror_error_set with vsnprintf returning -1
+	 */
+	cerror_test_vsnprintf_attempts_before_fail = 0;
+	cerror_test_vsnprintf_fail_return_value    = -1;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 2 );
+
+	if( cerror_test_vsnprintf_attempts_before_fail != -1 )
+	{
+		cerror_test_vsnprintf_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+	}
+	libcerror_error_free(
+	  &error );
+
+	/* Test libcerror_error_set with vsnprintf returning
+	 * a value larger than LIBCERROR_MESSAGE_MAXIMUM_SIZE
+	 */
+	cerror_test_vsnprintf_attempts_before_fail = 0;
+	cerror_test_vsnprintf_fail_return_value    = 2 * LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 6 );
+
+	if( cerror_test_vsnprintf_attempts_before_fail != -1 )
+	{
+		cerror_test_vsnprintf_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+	}
+	libcerror_error_free(
+	  &error );
+
+#endif /* defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_set_static function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_set_static(
+     void )
+{
+	char string[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	const char *message      = "Unable to read header.";
+	int print_count          = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	libcerror_error_set_static(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 message );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	LIBCERROR_ERROR_SET_STATIC(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Unable to open file: 100% complete." );
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_IO_ERROR_READ_FAILED );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               64 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 36 );
+
+	result = narrow_string_compare(
+	          string,
+	          "Unable to open file: 100% complete.",
+	          36 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	/* Test if the message string is referenced instead of copied
+	 */
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->number_of_messages",
+	 ( (libcerror_internal_error_t *) error )->number_of_messages,
+	 2 );
+
+	result = ( ( (libcerror_internal_error_t *) error )->messages[ 0 ] == message );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->flags[ 0 ]",
+	 (int) ( (libcerror_internal_error_t *) error )->flags[ 0 ],
+	 LIBCERROR_MESSAGE_FLAG_STATIC );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_error->message_data_size",
+	 ( (libcerror_internal_error_t *) error )->message_data_size,
+	 (size_t) 0 );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	libcerror_error_set_static(
+	 NULL,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 message );
+
+	libcerror_error_set_static(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 NULL );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_get_depth function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_get_depth(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int depth                = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcerror_error_get_depth(
+	          error,
+	          &depth );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "depth",
+	 depth,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libcerror_error_get_depth(
+	          NULL,
+	          &depth );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_get_depth(
+	          error,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_truncate function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_truncate(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int checkpoint_depth     = 0;
+	int depth                = 0;
+	int result               = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+	size_t message_data_size = 0;
+#endif
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 1 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	result = libcerror_error_get_depth(
+	          error,
+	          &checkpoint_depth );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+	message_data_size = ( (libcerror_internal_error_t *) error )->message_data_size;
+#endif
+
+	libcerror_error_set_static(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 3 );
+
+	/* Test regular cases
+	 */
+	result = libcerror_error_truncate(
+	          error,
+	          checkpoint_depth );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcerror_error_get_depth(
+	          error,
+	          &depth );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "depth",
+	 depth,
+	 checkpoint_depth );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "message_data_size",
+	 ( (libcerror_internal_error_t *) error )->message_data_size,
+	 message_data_size );
+#endif
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	          LIBCERROR_RUNTIME_ERROR_GENERIC );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Truncating to the current depth leaves the error unchanged
+	 */
+	result = libcerror_error_truncate(
+	          error,
+	          depth );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libcerror_error_truncate(
+	          NULL,
+	          0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_truncate(
+	          error,
+	          -1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_truncate(
+	          error,
+	          depth + 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_matches function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_matches(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	          LIBCERROR_RUNTIME_ERROR_GENERIC );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcerror_error_matches(
+	          error,
+	          LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	          LIBCERROR_ARGUMENT_ERROR_GENERIC );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcerror_error_matches(
+	          NULL,
+	          LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	          LIBCERROR_ARGUMENT_ERROR_GENERIC );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Tests the libcerror_error_format_deferred_message function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_format_deferred_message(
+     void )
+{
+	char long_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE + 16 ];
+	char message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE ];
+	char string[ 128 ];
+	char unterminated_string[ 4 ];
+
+	libcerror_error_t *error                   = NULL;
+	libcerror_internal_error_t *internal_error = NULL;
+	size_t message_size                        = 0;
+	int print_count                            = 0;
+	int result                                 = 0;
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	const char *expected_string                = "function: invalid value: 5.\r\nUnable to read 512 bytes at offset: 0x00001000.";
+#else
+	const char *expected_string                = "function: invalid value: 5.\nUnable to read 512 bytes at offset: 0x00001000.";
+#endif
+
+	/* Initialize test
+	 */
+	result = libcerror_set_deferred_formatting(
+	          1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+	 "%s: invalid value: %d.",
+	 "function",
+	 5 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Unable to read %" PRIzd " bytes at offset: 0x%08" PRIx64 ".",
+	 (size_t) 512,
+	 (uint64_t) 4096 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	internal_error = (libcerror_internal_error_t *) error;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->number_of_messages",
+	 internal_error->number_of_messages,
+	 2 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->flags[ 0 ]",
+	 (int) internal_error->flags[ 0 ],
+	 LIBCERROR_MESSAGE_FLAG_DEFERRED );
+
+	/* Test regular cases
+	 */
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          0,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "message_size",
+	 message_size,
+	 (size_t) 28 );
+
+	result = narrow_string_compare(
+	          message_string,
+	          "function: invalid value: 5.",
+	          28 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 (int) narrow_string_length( expected_string ) + 1 );
+
+	result = narrow_string_compare(
+	          string,
+	          expected_string,
+	          narrow_string_length( expected_string ) + 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a deferred message that is truncated
+	 */
+	memory_set(
+	 long_string,
+	 'A',
+	 LIBCERROR_MESSAGE_MAXIMUM_SIZE + 15 );
+
+	long_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE + 15 ] = 0;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "%s",
+	 long_string );
+
+	internal_error = (libcerror_internal_error_t *) error;
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          2,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "message_size",
+	 message_size,
+	 (size_t) LIBCERROR_MESSAGE_MAXIMUM_SIZE );
+
+	result = narrow_string_compare(
+	          &( message_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE - 5 ] ),
+	          "A...",
+	          5 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a format string that cannot be deferred
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "%2$s %1$s",
+	 "world",
+	 "hello" );
+
+	internal_error = (libcerror_internal_error_t *) error;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->flags[ 3 ]",
+	 (int) internal_error->flags[ 3 ],
+	 0 );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 12 );
+
+	/* Test error cases
+	 */
+	result = libcerror_error_format_deferred_message(
+	          NULL,
+	          0,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          -1,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          4,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          3,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          0,
+	          NULL,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          0,
+	          message_string,
+	          3,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_format_deferred_message(
+	          internal_error,
+	          0,
+	          message_string,
+	          LIBCERROR_MESSAGE_MAXIMUM_SIZE,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Test a string with a precision that is not terminated
+	 */
+	memory_copy(
+	 unterminated_string,
+	 "abcd",
+	 4 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "value: %.4s.",
+	 unterminated_string );
+
+	internal_error = (libcerror_internal_error_t *) error;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "internal_error->flags[ 4 ]",
+	 (int) internal_error->flags[ 4 ],
+	 0 );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 13 );
+
+	result = narrow_string_compare(
+	          string,
+	          "value: abcd.",
+	          13 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_set_deferred_formatting(
+	          0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	libcerror_set_deferred_formatting(
+	 0 );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+/* Tests the libcerror_error_fprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_fprint(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	system_character_t *message   = NULL;
+	system_character_t **messages = NULL;
+	FILE *stream                  = NULL;
+	const char *expected_string   = NULL;
+	int expected_print_count      = 0;
+	int print_count               = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	/* Test libcerror_error_fprint
+	 */
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	expected_string      = "Test error.\r\n";
+	expected_print_count = 13;
+#else
+	expected_string      = "Test error.\n";
+	expected_print_count = 12;
+#endif
+	print_count = libcerror_error_fprint(
+	               error,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count )
+
+	result = cerror_test_compare_stream(
+	          stream,
+	          expected_string,
+	          expected_print_count );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	message = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+
+	print_count = libcerror_error_fprint(
+	               error,
+	               stream );
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = message;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 0 )
+
+	/* Test error cases
+	 */
+	print_count = libcerror_error_fprint(
+	               NULL,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_fprint(
+	               error,
+	               NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	messages = ( (libcerror_internal_error_t *) error )->messages;
+
+	( (libcerror_internal_error_t *) error )->messages = NULL;
+
+	print_count = libcerror_error_fprint(
+	               error,
+	               stream );
+
+	( (libcerror_internal_error_t *) error )->messages = messages;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED )
+
+	/* Test libcerror_error_fprint with fprintf returning -1
+	 */
+	cerror_test_fprintf_attempts_before_fail = 0;
+
+	print_count = libcerror_error_fprint(
+	               error,
+	               stream );
+
+	if( cerror_test_fprintf_attempts_before_fail != -1 )
+	{
+		cerror_test_fprintf_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "print_count",
+		 print_count,
+		 -1 )
+	}
+#endif /* defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED ) */
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+	/* Test internal_error->messages == NULL
+	 */
+	libcerror_error_initialize(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	( (libcerror_internal_error_t *) error )->number_of_messages = 0;
+	( (libcerror_internal_error_t *) error )->messages           = NULL;
+	( (libcerror_internal_error_t *) error )->sizes              = NULL;
+
+	print_count = libcerror_error_fprint(
+	               error,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	libcerror_error_free(
+	 &error );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+
+	fclose(
+	 stream );
+
+	stream = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_backtrace_fprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_backtrace_fprint(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	system_character_t *message   = NULL;
+	system_character_t **messages = NULL;
+	FILE *stream                  = NULL;
+	const char *expected_string   = NULL;
+	int expected_print_count      = 0;
+	int print_count               = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	expected_string      = "Test error 1.\r\nTest error 2.\r\n";
+	expected_print_count = 30;
+#else
+	expected_string      = "Test error 1.\nTest error 2.\n";
+	expected_print_count = 28;
+#endif
+	print_count = libcerror_error_backtrace_fprint(
+	               error,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count )
+
+	result = cerror_test_compare_stream(
+	          stream,
+	          expected_string,
+	          expected_print_count );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	expected_print_count = 15;
+#else
+	expected_print_count = 14;
+#endif
+	message = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+
+	print_count = libcerror_error_backtrace_fprint(
+	               error,
+	               stream );
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = message;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count )
+
+	/* Test error cases
+	 */
+	print_count = libcerror_error_backtrace_fprint(
+	               NULL,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_backtrace_fprint(
+	               error,
+	               NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	messages = ( (libcerror_internal_error_t *) error )->messages;
+
+	( (libcerror_internal_error_t *) error )->messages = NULL;
+
+	print_count = libcerror_error_backtrace_fprint(
+	               error,
+	               stream );
+
+	( (libcerror_internal_error_t *) error )->messages = messages;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED )
+
+	/* Test libcerror_error_backtrace_fprint with fprintf returning -1
+	 */
+	cerror_test_fprintf_attempts_before_fail = 0;
+
+	print_count = libcerror_error_backtrace_fprint(
+	               error,
+	               stream );
+
+	if( cerror_test_fprintf_attempts_before_fail != -1 )
+	{
+		cerror_test_fprintf_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "print_count",
+		 print_count,
+		 -1 )
+	}
+#endif /* defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED ) */
+
+	/* Test libcerror_error_backtrace_fprint with an end-of-string character in a message
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test%cerror.",
+	 0 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	fclose(
+	 stream );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	expected_string      = "Test\r\n";
+	expected_print_count = 6;
+#else
+	expected_string      = "Test\n";
+	expected_print_count = 5;
+#endif
+	print_count = libcerror_error_backtrace_fprint(
+	               error,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count )
+
+	result = cerror_test_compare_stream(
+	          stream,
+	          expected_string,
+	          expected_print_count );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fclose(
+	 stream );
+
+	stream = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* The end-of-line characters written by libcerror_error_backtrace_write_fd
+ */
+#if ( defined( WINAPI ) || defined( __MINGW32__ ) ) && ( !defined( HAVE_WRITEV ) || defined( HAVE_WIDE_SYSTEM_CHARACTER ) )
+#define CERROR_TEST_WRITE_FD_END_OF_LINE	"\r\n"
+#else
+#define CERROR_TEST_WRITE_FD_END_OF_LINE	"\n"
+#endif
+
+/* Tests the libcerror_error_backtrace_write_fd function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_backtrace_write_fd(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	FILE *stream             = NULL;
+	size_t end_of_line_size  = sizeof( CERROR_TEST_WRITE_FD_END_OF_LINE ) - 1;
+	int message_index        = 0;
+	int result               = 0;
+	int write_count          = 0;
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 2 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	/* Test regular cases
+	 */
+	write_count = libcerror_error_backtrace_write_fd(
+	               error,
+	               fileno( stream ) );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "write_count",
+	 write_count,
+	 (int) ( 26 + ( 2 * end_of_line_size ) ) );
+
+	result = cerror_test_compare_stream(
+	          stream,
+	          "Test error 1." CERROR_TEST_WRITE_FD_END_OF_LINE "Test error 2." CERROR_TEST_WRITE_FD_END_OF_LINE,
+	          26 + ( 2 * end_of_line_size ) );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test a backtrace with more I/O vectors than fit on the stack
+	 */
+	libcerror_error_free(
+	 &error );
+
+	for( message_index = 0;
+	     message_index < 40;
+	     message_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error." );
+	}
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	fclose(
+	 stream );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	write_count = libcerror_error_backtrace_write_fd(
+	               error,
+	               fileno( stream ) );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "write_count",
+	 write_count,
+	 (int) ( 40 * ( 11 + end_of_line_size ) ) );
+
+	result = cerror_test_compare_stream(
+	          stream,
+	          "Test error." CERROR_TEST_WRITE_FD_END_OF_LINE "Test error." CERROR_TEST_WRITE_FD_END_OF_LINE "Test error.",
+	          ( 3 * 11 ) + ( 2 * end_of_line_size ) );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	write_count = libcerror_error_backtrace_write_fd(
+	               NULL,
+	               fileno( stream ) );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "write_count",
+	 write_count,
+	 -1 );
+
+	write_count = libcerror_error_backtrace_write_fd(
+	               error,
+	               -1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "write_count",
+	 write_count,
+	 -1 );
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fclose(
+	 stream );
+
+	stream = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_sprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_sprint(
+     void )
+{
+	char string[ 128 ];
+
+	libcerror_error_t *error         = NULL;
+	system_character_t *error_string = NULL;
+	system_character_t **messages    = NULL;
+	size_t *sizes                    = NULL;
+	int print_count                  = 0;
+	int required_size                = 0;
+	int result                       = 1;
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 12 )
+
+	result = narrow_string_compare(
+	          string,
+	          "Test error.",
+	          11 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test retrieving the required size of the string
+	 */
+	required_size = libcerror_error_sprint(
+	                 error,
+	                 NULL,
+	                 0 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "required_size",
+	 required_size,
+	 1 );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               (size_t) required_size );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               (size_t) required_size - 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	error_string = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = error_string;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 0 )
+
+	libcerror_system_set_error(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 0,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "print_count",
+	 print_count,
+	 24 )
+
+	/* Note that the rest of the error message is system dependent.
+	 */
+	result = narrow_string_compare(
+	          string,
+	          "Test error with error: ",
+	          23 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	print_count = libcerror_error_sprint(
+	               NULL,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	messages = ( (libcerror_internal_error_t *) error )->messages;
+
+	( (libcerror_internal_error_t *) error )->messages = NULL;
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	( (libcerror_internal_error_t *) error )->messages = messages;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	sizes = ( (libcerror_internal_error_t *) error )->sizes;
+
+	( (libcerror_internal_error_t *) error )->sizes = NULL;
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	( (libcerror_internal_error_t *) error )->sizes = sizes;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               NULL,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               (size_t) SSIZE_MAX + 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               10 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+#if defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY )
+
+	/* Test libcerror_error_sprint with memcpy returning NULL
+	 */
+	cerror_test_memcpy_attempts_before_fail = 0;
+
+	print_count = libcerror_error_sprint(
+	               error,
+	               string,
+	               128 );
+
+	if( cerror_test_memcpy_attempts_before_fail != -1 )
+	{
+		cerror_test_memcpy_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "print_count",
+		 print_count,
+		 -1 )
+	}
+	libcerror_error_free(
+	  &error );
+
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY ) */
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_backtrace_sprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_backtrace_sprint(
+     void )
+{
+	char string[ 128 ];
+
+	libcerror_error_t *error         = NULL;
+	system_character_t *error_string = NULL;
+	system_character_t **messages    = NULL;
+	size_t *sizes                    = NULL;
+	const char *expected_string      = NULL;
+	int expected_print_count         = 0;
+	int print_count                  = 0;
+	int required_size                = 0;
+	int result                       = 1;
+
+	/* Initialize test
+	 */
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving the required size of the string
+	 */
+	required_size = libcerror_error_backtrace_sprint(
+	                 error,
+	                 NULL,
+	                 0 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "required_size",
+	 required_size,
+	 1 );
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               (size_t) required_size );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               (size_t) required_size - 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	expected_string      = "Test error 1.\r\nTest error 2.";
+	expected_print_count = 29;
+#else
+	expected_string      = "Test error 1.\nTest error 2.";
+	expected_print_count = 28;
+#endif
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count )
+
+	result = narrow_string_compare(
+	          string,
+	          expected_string,
+	          expected_print_count );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	error_string = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               128 );
+
+	( (libcerror_internal_error_t *) error )->messages[ 0 ] = error_string;
+
+	expected_string      = "Test error 2.";
+	expected_print_count = 14;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count )
+
+	result = narrow_string_compare(
+	          string,
+	          expected_string,
+	          expected_print_count );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	print_count = libcerror_error_backtrace_sprint(
+	               NULL,
+	               string,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               NULL,
+	               128 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               (size_t) SSIZE_MAX + 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	messages = ( (libcerror_internal_error_t *) error )->messages;
+
+	( (libcerror_internal_error_t *) error )->messages = NULL;
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               128 );
+
+	( (libcerror_internal_error_t *) error )->messages = messages;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	sizes = ( (libcerror_internal_error_t *) error )->sizes;
+
+	( (libcerror_internal_error_t *) error )->sizes = NULL;
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               128 );
+
+	( (libcerror_internal_error_t *) error )->sizes = sizes;
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               10 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               13 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 )
+
+#if defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY )
+
+	/* Test libcerror_error_backtrace_sprint with memcpy returning NULL
+	 */
+	cerror_test_memcpy_attempts_before_fail = 0;
+
+	print_count = libcerror_error_backtrace_sprint(
+	               error,
+	               string,
+	               128 );
+
+	if( cerror_test_memcpy_attempts_before_fail != -1 )
+	{
+		cerror_test_memcpy_attempts_before_fail = -1;
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "print_count",
+		 print_count,
+		 -1 )
+	}
+	libcerror_error_free(
+	  &error );
+
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY ) */
+
+	/* Clean up
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_backtrace_sprint_allocated and libcerror_error_string_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_backtrace_sprint_allocated(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	char *string                = NULL;
+	const char *expected_string = NULL;
+	size_t expected_string_size = 0;
+	size_t string_size          = 0;
+	int message_index           = 0;
+	int result                  = 0;
+
+	/* Initialize test
 	 */
 	libcerror_error_set(
 	 &error,
@@ -752,91 +3469,145 @@ int cerror_test_error_set(
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
 	 "Test error 1." );
 
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 2 );
+
 	CERROR_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	cerror_test_realloc_attempts_before_fail = 2;
+	/* Test regular cases
+	 */
+#if defined( WINAPI ) || defined( __MINGW32__ )
+	expected_string      = "Test error 1.\r\nTest error 2.";
+	expected_string_size = 29;
+#else
+	expected_string      = "Test error 1.\nTest error 2.";
+	expected_string_size = 28;
+#endif
+	result = libcerror_error_backtrace_sprint_allocated(
+	          error,
+	          &string,
+	          &string_size );
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 2." );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	if( cerror_test_realloc_attempts_before_fail != -1 )
-	{
-		cerror_test_realloc_attempts_before_fail = -1;
-	}
-	else
-	{
-		CERROR_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-	}
-	libcerror_error_free(
-	  &error );
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "string",
+	 string );
 
-#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "string_size",
+	 string_size,
+	 expected_string_size );
 
-	/* TODO test libcerror_error_get_system_format_string failing */
+	result = narrow_string_compare(
+	          string,
+	          expected_string,
+	          expected_string_size );
 
-#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK )
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	/* Test libcerror_error_set with vsnprintf returning -1
-	 */
-	cerror_test_vsnprintf_attempts_before_fail = 0;
-	cerror_test_vsnprintf_fail_return_value    = -1;
+	libcerror_error_string_free(
+	 &string );
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 2." );
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "string",
+	 string );
 
-	if( cerror_test_vsnprintf_attempts_before_fail != -1 )
-	{
-		cerror_test_vsnprintf_attempts_before_fail = -1;
-	}
-	else
+	/* Test a backtrace that is larger than the fixed size buffers of the callers
+	 */
+	for( message_index = 0;
+	     message_index < 256;
+	     message_index++ )
 	{
-		CERROR_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error with a message of some length: %d.",
+		 message_index );
 	}
-	libcerror_error_free(
-	  &error );
+	result = libcerror_error_backtrace_sprint_allocated(
+	          error,
+	          &string,
+	          &string_size );
 
-	/* Test libcerror_error_set with vsnprintf returning
-	 * a value larger than LIBCERROR_MESSAGE_MAXIMUM_SIZE
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "string_size",
+	 (int) string_size,
+	 8192 );
+
+	libcerror_error_string_free(
+	 &string );
+
+	/* Test error cases
 	 */
-	cerror_test_vsnprintf_attempts_before_fail = 0;
-	cerror_test_vsnprintf_fail_return_value    = 2 * LIBCERROR_MESSAGE_MAXIMUM_SIZE;
+	result = libcerror_error_backtrace_sprint_allocated(
+	          NULL,
+	          &string,
+	          &string_size );
 
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 6." );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	if( cerror_test_vsnprintf_attempts_before_fail != -1 )
-	{
-		cerror_test_vsnprintf_attempts_before_fail = -1;
-	}
-	else
-	{
-		CERROR_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-	}
+	result = libcerror_error_backtrace_sprint_allocated(
+	          error,
+	          NULL,
+	          &string_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_backtrace_sprint_allocated(
+	          error,
+	          &string,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_string_free(
+	 NULL );
+
+	/* Clean up
+	 */
 	libcerror_error_free(
 	  &error );
 
-#endif /* defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) */
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	return( 1 );
 
 on_error:
+	if( string != NULL )
+	{
+		libcerror_error_string_free(
+		 &string );
+	}
 	if( error != NULL )
 	{
 		libcerror_error_free(
@@ -845,45 +3616,72 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libcerror_error_matches function
+/* Tests the libcerror_error_get_number_of_frames function
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_matches(
+int cerror_test_error_get_number_of_frames(
      void )
 {
 	libcerror_error_t *error = NULL;
+	int number_of_frames     = 0;
 	int result               = 0;
 
+	/* Initialize test
+	 */
 	libcerror_error_set(
 	 &error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
+	 "Test error 1." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 2." );
 
 	CERROR_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	result = libcerror_error_matches(
+	/* Test regular cases
+	 */
+	result = libcerror_error_get_number_of_frames(
 	          error,
-	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	          LIBCERROR_RUNTIME_ERROR_GENERIC );
+	          &number_of_frames );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-	result = libcerror_error_matches(
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_frames",
+	 number_of_frames,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libcerror_error_get_number_of_frames(
+	          NULL,
+	          &number_of_frames );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_error_get_number_of_frames(
 	          error,
-	          LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-	          LIBCERROR_ARGUMENT_ERROR_GENERIC );
+	          NULL );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
+	/* Clean up
+	 */
 	libcerror_error_free(
 	  &error );
 
@@ -891,16 +3689,6 @@ int cerror_test_error_matches(
 	 "error",
 	 error );
 
-	result = libcerror_error_matches(
-	          NULL,
-	          LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-	          LIBCERROR_ARGUMENT_ERROR_GENERIC );
-
-	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 0 );
-
 	return( 1 );
 
 on_error:
@@ -912,20 +3700,18 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libcerror_error_fprint function
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Tests the libcerror_error_get_frame_message function
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_fprint(
+int cerror_test_error_get_frame_message(
      void )
 {
-	libcerror_error_t *error      = NULL;
-	system_character_t *message   = NULL;
-	system_character_t **messages = NULL;
-	FILE *stream                  = NULL;
-	const char *expected_string   = NULL;
-	int expected_print_count      = 0;
-	int print_count               = 0;
-	int result                    = 0;
+	libcerror_error_t *error = NULL;
+	const char *message      = NULL;
+	size_t message_size      = 0;
+	int result               = 0;
 
 	/* Initialize test
 	 */
@@ -933,118 +3719,144 @@ int cerror_test_error_fprint(
 	 &error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
+	 "Test error %d.",
+	 1 );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	result = libcerror_set_deferred_formatting(
+	          1 );
 
-	stream = tmpfile();
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "stream",
-	 stream );
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 2 );
 
-	/* Test libcerror_error_fprint
-	 */
-#if defined( WINAPI ) || defined( __MINGW32__ )
-	expected_string      = "Test error.\r\n";
-	expected_print_count = 13;
-#else
-	expected_string      = "Test error.\n";
-	expected_print_count = 12;
-#endif
-	print_count = libcerror_error_fprint(
-	               error,
-	               stream );
+	result = libcerror_set_deferred_formatting(
+	          0 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 expected_print_count )
+	 "result",
+	 result,
+	 1 );
 
-	result = cerror_test_compare_stream(
-	          stream,
-	          expected_string,
-	          expected_print_count );
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcerror_error_get_frame_message(
+	          error,
+	          0,
+	          &message,
+	          &message_size );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-	message = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "message",
+	 message );
 
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "message_size",
+	 message_size,
+	 (size_t) 14 );
 
-	print_count = libcerror_error_fprint(
-	               error,
-	               stream );
+	result = narrow_string_compare(
+	          message,
+	          "Test error 1.",
+	          14 );
 
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = message;
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
+	/* The message is not copied
+	 */
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 0 )
+	 "message == messages[ 0 ]",
+	 (int) ( message == ( (libcerror_internal_error_t *) error )->messages[ 0 ] ),
+	 1 );
+
+	/* Test a deferred message
+	 */
+	result = libcerror_error_get_frame_message(
+	          error,
+	          1,
+	          &message,
+	          &message_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	/* Test error cases
 	 */
-	print_count = libcerror_error_fprint(
-	               NULL,
-	               stream );
+	result = libcerror_error_get_frame_message(
+	          NULL,
+	          0,
+	          &message,
+	          &message_size );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	 "result",
+	 result,
+	 -1 );
 
-	print_count = libcerror_error_fprint(
-	               error,
-	               NULL );
+	result = libcerror_error_get_frame_message(
+	          error,
+	          -1,
+	          &message,
+	          &message_size );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-	messages = ( (libcerror_internal_error_t *) error )->messages;
-
-	( (libcerror_internal_error_t *) error )->messages = NULL;
-
-	print_count = libcerror_error_fprint(
-	               error,
-	               stream );
+	 "result",
+	 result,
+	 -1 );
 
-	( (libcerror_internal_error_t *) error )->messages = messages;
+	result = libcerror_error_get_frame_message(
+	          error,
+	          2,
+	          &message,
+	          &message_size );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	 "result",
+	 result,
+	 -1 );
 
-#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED )
+	result = libcerror_error_get_frame_message(
+	          error,
+	          0,
+	          NULL,
+	          &message_size );
 
-	/* Test libcerror_error_fprint with fprintf returning -1
-	 */
-	cerror_test_fprintf_attempts_before_fail = 0;
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	print_count = libcerror_error_fprint(
-	               error,
-	               stream );
+	result = libcerror_error_get_frame_message(
+	          error,
+	          0,
+	          &message,
+	          NULL );
 
-	if( cerror_test_fprintf_attempts_before_fail != -1 )
-	{
-		cerror_test_fprintf_attempts_before_fail = -1;
-	}
-	else
-	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "print_count",
-		 print_count,
-		 -1 )
-	}
-#endif /* defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED ) */
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	/* Clean up
 	 */
@@ -1055,44 +3867,6 @@ int cerror_test_error_fprint(
 	 "error",
 	 error );
 
-#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
-
-	/* Test internal_error->messages == NULL
-	 */
-	libcerror_error_initialize(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC );
-
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	( (libcerror_internal_error_t *) error )->number_of_messages = 0;
-	( (libcerror_internal_error_t *) error )->messages           = NULL;
-	( (libcerror_internal_error_t *) error )->sizes              = NULL;
-
-	print_count = libcerror_error_fprint(
-	               error,
-	               stream );
-
-	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-	memory_free(
-	 error );
-
-	error = NULL;
-
-#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
-
-	fclose(
-	 stream );
-
-	stream = NULL;
-
 	return( 1 );
 
 on_error:
@@ -1101,28 +3875,68 @@ on_error:
 		libcerror_error_free(
 		  &error );
 	}
-	if( stream != NULL )
+	libcerror_set_deferred_formatting(
+	 0 );
+
+	return( 0 );
+}
+
+/* Test backtrace visit callback that concatenates the messages into the context
+ * Returns 1 to continue or -1 on error
+ */
+int cerror_test_error_backtrace_visit_callback(
+     int frame_index,
+     const char *message,
+     size_t message_size,
+     void *context )
+{
+	char *string = (char *) context;
+
+	if( ( frame_index < 0 )
+	 || ( frame_index > 1 )
+	 || ( message == NULL )
+	 || ( message_size != 14 ) )
 	{
-		fclose(
-		 stream );
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( string[ frame_index * 13 ] ),
+	     message,
+	     message_size ) == NULL )
+	{
+		return( -1 );
 	}
+	return( 1 );
+}
+
+/* Test backtrace visit callback that stops the visit
+ * Returns 0 to stop
+ */
+int cerror_test_error_backtrace_visit_stop_callback(
+     int frame_index,
+     const char *message CERROR_TEST_ATTRIBUTE_UNUSED,
+     size_t message_size CERROR_TEST_ATTRIBUTE_UNUSED,
+     void *context )
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( message )
+	CERROR_TEST_UNREFERENCED_PARAMETER( message_size )
+
+	*( (int *) context ) = frame_index;
+
 	return( 0 );
 }
 
-/* Tests the libcerror_error_backtrace_fprint function
+/* Tests the libcerror_error_backtrace_visit function
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_backtrace_fprint(
+int cerror_test_error_backtrace_visit(
      void )
 {
-	libcerror_error_t *error      = NULL;
-	system_character_t *message   = NULL;
-	system_character_t **messages = NULL;
-	FILE *stream                  = NULL;
-	const char *expected_string   = NULL;
-	int expected_print_count      = 0;
-	int print_count               = 0;
-	int result                    = 0;
+	char string[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	int frame_index          = -1;
+	int result               = 0;
 
 	/* Initialize test
 	 */
@@ -1132,129 +3946,91 @@ int cerror_test_error_backtrace_fprint(
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
 	 "Test error 1." );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	result = libcerror_set_deferred_formatting(
+	          1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	libcerror_error_set(
 	 &error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 2." );
+	 "Test error %d.",
+	 2 );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	result = libcerror_set_deferred_formatting(
+	          0 );
 
-	stream = tmpfile();
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "stream",
-	 stream );
-
-#if defined( WINAPI ) || defined( __MINGW32__ )
-	expected_string      = "Test error 1.\r\nTest error 2.\r\n";
-	expected_print_count = 30;
-#else
-	expected_string      = "Test error 1.\nTest error 2.\n";
-	expected_print_count = 28;
-#endif
-	print_count = libcerror_error_backtrace_fprint(
-	               error,
-	               stream );
-
-	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 expected_print_count )
+	 "error",
+	 error );
 
-	result = cerror_test_compare_stream(
-	          stream,
-	          expected_string,
-	          expected_print_count );
+	/* Test regular cases
+	 */
+	result = libcerror_error_backtrace_visit(
+	          error,
+	          &cerror_test_error_backtrace_visit_callback,
+	          (void *) string );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-#if defined( WINAPI ) || defined( __MINGW32__ )
-	expected_print_count = 15;
-#else
-	expected_print_count = 14;
-#endif
-	message = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
-
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
-
-	print_count = libcerror_error_backtrace_fprint(
-	               error,
-	               stream );
-
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = message;
+	result = narrow_string_compare(
+	          string,
+	          "Test error 1.Test error 2.",
+	          27 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 expected_print_count )
+	 "result",
+	 result,
+	 0 );
 
-	/* Test error cases
-	 */
-	print_count = libcerror_error_backtrace_fprint(
-	               NULL,
-	               stream );
+	result = libcerror_error_backtrace_visit(
+	          error,
+	          &cerror_test_error_backtrace_visit_stop_callback,
+	          (void *) &frame_index );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-	print_count = libcerror_error_backtrace_fprint(
-	               error,
-	               NULL );
+	 "result",
+	 result,
+	 0 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-	messages = ( (libcerror_internal_error_t *) error )->messages;
-
-	( (libcerror_internal_error_t *) error )->messages = NULL;
-
-	print_count = libcerror_error_backtrace_fprint(
-	               error,
-	               stream );
+	 "frame_index",
+	 frame_index,
+	 0 );
 
-	( (libcerror_internal_error_t *) error )->messages = messages;
+	/* Test error cases
+	 */
+	result = libcerror_error_backtrace_visit(
+	          NULL,
+	          &cerror_test_error_backtrace_visit_callback,
+	          (void *) string );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-#if defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED )
-
-	/* Test libcerror_error_backtrace_fprint with fprintf returning -1
-	 */
-	cerror_test_fprintf_attempts_before_fail = 0;
+	 "result",
+	 result,
+	 -1 );
 
-	print_count = libcerror_error_backtrace_fprint(
-	               error,
-	               stream );
+	result = libcerror_error_backtrace_visit(
+	          error,
+	          NULL,
+	          (void *) string );
 
-	if( cerror_test_fprintf_attempts_before_fail != -1 )
-	{
-		cerror_test_fprintf_attempts_before_fail = -1;
-	}
-	else
-	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "print_count",
-		 print_count,
-		 -1 )
-	}
-#endif /* defined( HAVE_CERROR_TEST_FUNCTION_HOOK ) && defined( OPTIMIZATION_DISABLED ) */
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	/* Clean up
 	 */
@@ -1265,11 +4041,6 @@ int cerror_test_error_backtrace_fprint(
 	 "error",
 	 error );
 
-	fclose(
-	 stream );
-
-	stream = NULL;
-
 	return( 1 );
 
 on_error:
@@ -1278,104 +4049,128 @@ on_error:
 		libcerror_error_free(
 		  &error );
 	}
-	if( stream != NULL )
-	{
-		fclose(
-		 stream );
-	}
+	libcerror_set_deferred_formatting(
+	 0 );
+
 	return( 0 );
 }
 
-/* Tests the libcerror_error_sprint function
+/* Sets the error used by the JSON backtrace tests
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_sprint(
-     void )
+int cerror_test_error_set_json_test_error(
+     libcerror_error_t **error )
 {
-	char string[ 128 ];
+	int result = 0;
 
-	libcerror_error_t *error         = NULL;
-	system_character_t *error_string = NULL;
-	system_character_t **messages    = NULL;
-	size_t *sizes                    = NULL;
-	int print_count                  = 0;
-	int result                       = 1;
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error 1." );
 
-	/* Initialize test
+	/* A message with characters that are escaped and a byte that is not valid UTF-8
 	 */
 	libcerror_error_set(
-	 &error,
+	 error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error." );
-
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	 "Unable to open: %s.",
+	 "\"C:\\Test\"\t\xc3\xa9\xff" );
 
-	print_count = libcerror_error_sprint(
-	               error,
-	               string,
-	               128 );
+	result = libcerror_set_deferred_formatting(
+	          1 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 12 )
+	 "result",
+	 result,
+	 1 );
 
-	result = narrow_string_compare(
-	          string,
-	          "Test error.",
-	          11 );
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error %d.",
+	 3 );
+
+	result = libcerror_set_deferred_formatting(
+	          0 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
-	error_string = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 *error );
 
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+	return( 1 );
 
-	print_count = libcerror_error_sprint(
-	               error,
-	               string,
-	               128 );
+on_error:
+	libcerror_set_deferred_formatting(
+	 0 );
 
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = error_string;
+	return( 0 );
+}
+
+/* Tests the libcerror_error_backtrace_json_sprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_backtrace_json_sprint(
+     void )
+{
+	char string[ 256 ];
+
+	libcerror_error_t *error    = NULL;
+	const char *expected_string = "{\"domain\":114,\"code\":0,\"domain_name\":\"runtime\",\"frames\":["
+	                              "\"Test error 1.\","
+	                              "\"Unable to open: \\\"C:\\\\Test\\\"\\t\xc3\xa9\\ufffd.\","
+	                              "\"Test error 3.\"]}";
+	size_t expected_length      = 0;
+	int print_count             = 0;
+	int required_size           = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = cerror_test_error_set_json_test_error(
+	          &error );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 0 )
+	 "result",
+	 result,
+	 1 );
 
-	libcerror_system_set_error(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 0,
-	 "Test error." );
+	expected_length = narrow_string_length(
+	                   expected_string );
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	/* Test regular cases
+	 */
+	required_size = libcerror_error_backtrace_json_sprint(
+	                 error,
+	                 NULL,
+	                 0 );
 
-	print_count = libcerror_error_sprint(
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "required_size",
+	 required_size,
+	 (int) expected_length + 1 );
+
+	print_count = libcerror_error_backtrace_json_sprint(
 	               error,
 	               string,
-	               128 );
+	               (size_t) required_size );
 
-	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 24 )
+	 (int) expected_length );
 
-	/* Note that the rest of the error message is system dependent.
-	 */
 	result = narrow_string_compare(
 	          string,
-	          "Test error with error: ",
-	          23 );
+	          expected_string,
+	          expected_length + 1 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1384,104 +4179,197 @@ int cerror_test_error_sprint(
 
 	/* Test error cases
 	 */
-	print_count = libcerror_error_sprint(
-	               NULL,
+	print_count = libcerror_error_backtrace_json_sprint(
+	               error,
 	               string,
-	               128 );
+	               (size_t) required_size - 1 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 -1 )
-
-	messages = ( (libcerror_internal_error_t *) error )->messages;
-
-	( (libcerror_internal_error_t *) error )->messages = NULL;
+	 -1 );
 
-	print_count = libcerror_error_sprint(
+	print_count = libcerror_error_backtrace_json_sprint(
 	               error,
 	               string,
-	               128 );
-
-	( (libcerror_internal_error_t *) error )->messages = messages;
+	               16 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 -1 )
-
-	sizes = ( (libcerror_internal_error_t *) error )->sizes;
-
-	( (libcerror_internal_error_t *) error )->sizes = NULL;
+	 -1 );
 
-	print_count = libcerror_error_sprint(
-	               error,
+	print_count = libcerror_error_backtrace_json_sprint(
+	               NULL,
 	               string,
-	               128 );
-
-	( (libcerror_internal_error_t *) error )->sizes = sizes;
+	               256 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 -1 )
+	 -1 );
 
-	print_count = libcerror_error_sprint(
+	print_count = libcerror_error_backtrace_json_sprint(
 	               error,
 	               NULL,
-	               128 );
+	               256 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 -1 )
+	 -1 );
 
-	print_count = libcerror_error_sprint(
+	print_count = libcerror_error_backtrace_json_sprint(
 	               error,
 	               string,
-	               (size_t) SSIZE_MAX + 1 );
+	               0 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 -1 )
+	 -1 );
 
-	print_count = libcerror_error_sprint(
+	/* Clean up
+	 */
+	libcerror_error_free(
+	  &error );
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		  &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_error_backtrace_json_fprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_error_backtrace_json_fprint(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	FILE *stream                = NULL;
+	const char *expected_string = "{\"domain\":114,\"code\":0,\"domain_name\":\"runtime\",\"frames\":["
+	                              "\"Test error 1.\","
+	                              "\"Unable to open: \\\"C:\\\\Test\\\"\\t\xc3\xa9\\ufffd.\","
+	                              "\"Test error 3.\"]}\n";
+	size_t expected_length      = 0;
+	int message_index           = 0;
+	int print_count             = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = cerror_test_error_set_json_test_error(
+	          &error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	expected_length = narrow_string_length(
+	                   expected_string );
+
+	/* Test regular cases
+	 */
+	print_count = libcerror_error_backtrace_json_fprint(
 	               error,
-	               string,
-	               10 );
+	               stream );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
 	 "print_count",
 	 print_count,
-	 -1 )
+	 (int) expected_length );
 
-#if defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY )
+	result = cerror_test_compare_stream(
+	          stream,
+	          expected_string,
+	          expected_length );
 
-	/* Test libcerror_error_sprint with memcpy returning NULL
-	 */
-	cerror_test_memcpy_attempts_before_fail = 0;
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	print_count = libcerror_error_sprint(
-	               error,
-	               string,
-	               128 );
+	/* Test a message that is escaped in multiple parts
+	 */
+	libcerror_error_free(
+	 &error );
 
-	if( cerror_test_memcpy_attempts_before_fail != -1 )
-	{
-		cerror_test_memcpy_attempts_before_fail = -1;
-	}
-	else
+	for( message_index = 0;
+	     message_index < 4;
+	     message_index++ )
 	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "print_count",
-		 print_count,
-		 -1 )
+		/* Every control character is escaped as 6 characters
+		 */
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s%s%s",
+		 "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f",
+		 "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f",
+		 "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f" );
 	}
-	libcerror_error_free(
-	  &error );
+	fclose(
+	 stream );
+
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	result = libcerror_error_backtrace_json_sprint(
+	          error,
+	          NULL,
+	          0 );
+
+	/* The stream output contains an end-of-line character instead of the end-of-string character
+	 */
+	print_count = libcerror_error_backtrace_json_fprint(
+	               error,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 result );
+
+	/* Test error cases
+	 */
+	print_count = libcerror_error_backtrace_json_fprint(
+	               NULL,
+	               stream );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
 
-#endif /* defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY ) */
+	print_count = libcerror_error_backtrace_json_fprint(
+	               error,
+	               NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
 
 	/* Clean up
 	 */
@@ -1492,6 +4380,11 @@ int cerror_test_error_sprint(
 	 "error",
 	 error );
 
+	fclose(
+	 stream );
+
+	stream = NULL;
+
 	return( 1 );
 
 on_error:
@@ -1500,227 +4393,227 @@ on_error:
 		libcerror_error_free(
 		  &error );
 	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
 	return( 0 );
 }
 
-/* Tests the libcerror_error_backtrace_sprint function
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#if defined( HAVE_CERROR_TEST_MEMORY )
+
+/* Tests the allocation budgets of the error functions
+ * The error pool is flushed before each budget so that the budgets hold without it
  * Returns 1 if successful or 0 if not
  */
-int cerror_test_error_backtrace_sprint(
+int cerror_test_error_allocation_budgets(
      void )
 {
-	char string[ 128 ];
+	char long_string[ 1024 ];
+	char string[ 512 ];
 
-	libcerror_error_t *error         = NULL;
-	system_character_t *error_string = NULL;
-	system_character_t **messages    = NULL;
-	size_t *sizes                    = NULL;
-	const char *expected_string      = NULL;
-	int expected_print_count         = 0;
-	int print_count                  = 0;
-	int result                       = 1;
+	libcerror_error_t *error = NULL;
+	int error_index          = 0;
+	int result               = 0;
 
-	/* Initialize test
+	memory_set(
+	 long_string,
+	 'A',
+	 1023 );
+
+	long_string[ 1023 ] = 0;
+
+	/* Test that libcerror_error_set on a NULL error performs a single allocation
 	 */
-	libcerror_error_set(
-	 &error,
-	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 1." );
+	libcerror_pool_flush();
 
-	CERROR_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	cerror_test_memory_start_accounting();
 
 	libcerror_error_set(
 	 &error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 	 LIBCERROR_RUNTIME_ERROR_GENERIC,
-	 "Test error 2." );
+	 "Test error." );
+
+	cerror_test_memory_stop_accounting();
 
 	CERROR_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-#if defined( WINAPI ) || defined( __MINGW32__ )
-	expected_string      = "Test error 1.\r\nTest error 2.";
-	expected_print_count = 29;
-#else
-	expected_string      = "Test error 1.\nTest error 2.";
-	expected_print_count = 28;
-#endif
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               128 );
-
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 expected_print_count )
+	 "cerror_test_malloc_number_of_calls",
+	 cerror_test_malloc_number_of_calls,
+	 1 );
 
-	result = narrow_string_compare(
-	          string,
-	          expected_string,
-	          expected_print_count );
+	CERROR_TEST_ASSERT_LESS_THAN_INT(
+	 "cerror_test_malloc_number_of_bytes",
+	 (int) cerror_test_malloc_number_of_bytes,
+	 1024 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
+	 "cerror_test_realloc_number_of_calls",
+	 cerror_test_realloc_number_of_calls,
 	 0 );
 
-	error_string = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
+	libcerror_error_free(
+	 &error );
 
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
+	/* Test that a formatted message is formatted in a single pass without reallocation
+	 */
+	libcerror_pool_flush();
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               128 );
+	cerror_test_memory_start_accounting();
 
-	( (libcerror_internal_error_t *) error )->messages[ 0 ] = error_string;
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "%s: test error: %d.",
+	 "cerror_test_error_allocation_budgets",
+	 1 );
 
-	expected_string      = "Test error 2.";
-	expected_print_count = 14;
+	cerror_test_memory_stop_accounting();
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 expected_print_count )
-
-	result = narrow_string_compare(
-	          string,
-	          expected_string,
-	          expected_print_count );
+	 "cerror_test_malloc_number_of_calls",
+	 cerror_test_malloc_number_of_calls,
+	 1 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
+	 "cerror_test_realloc_number_of_calls",
+	 cerror_test_realloc_number_of_calls,
 	 0 );
 
-	/* Test error cases
+	libcerror_error_free(
+	 &error );
+
+	/* Test that a message that exceeds the initial message data requires a single reallocation
 	 */
-	print_count = libcerror_error_backtrace_sprint(
-	               NULL,
-	               string,
-	               128 );
+	libcerror_pool_flush();
 
-	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	cerror_test_memory_start_accounting();
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               NULL,
-	               128 );
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "Test error: %s.",
+	 long_string );
 
-	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	cerror_test_memory_stop_accounting();
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               (size_t) SSIZE_MAX + 1 );
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_malloc_number_of_calls",
+	 cerror_test_malloc_number_of_calls,
+	 1 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	 "cerror_test_realloc_number_of_calls",
+	 cerror_test_realloc_number_of_calls,
+	 1 );
 
-	messages = ( (libcerror_internal_error_t *) error )->messages;
+	libcerror_error_free(
+	 &error );
 
-	( (libcerror_internal_error_t *) error )->messages = NULL;
+	/* Test that a back trace of the initial number of messages requires no reallocation
+	 */
+	libcerror_pool_flush();
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               128 );
+	cerror_test_memory_start_accounting();
 
-	( (libcerror_internal_error_t *) error )->messages = messages;
+	for( error_index = 0;
+	     error_index < LIBCERROR_INITIAL_NUMBER_OF_MESSAGES;
+	     error_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error: %d.",
+		 error_index );
+	}
+	cerror_test_memory_stop_accounting();
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-	sizes = ( (libcerror_internal_error_t *) error )->sizes;
+	 "cerror_test_malloc_number_of_calls",
+	 cerror_test_malloc_number_of_calls,
+	 1 );
 
-	( (libcerror_internal_error_t *) error )->sizes = NULL;
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_realloc_number_of_calls",
+	 cerror_test_realloc_number_of_calls,
+	 0 );
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               128 );
+	/* Test that libcerror_error_backtrace_sprint does not allocate
+	 */
+	cerror_test_memory_start_accounting();
 
-	( (libcerror_internal_error_t *) error )->sizes = sizes;
+	result = libcerror_error_backtrace_sprint(
+	          error,
+	          string,
+	          512 );
 
-	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	cerror_test_memory_stop_accounting();
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               10 );
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "result",
+	 result,
+	 0 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
-
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               13 );
+	 "cerror_test_malloc_number_of_calls",
+	 cerror_test_malloc_number_of_calls,
+	 0 );
 
 	CERROR_TEST_ASSERT_EQUAL_INT(
-	 "print_count",
-	 print_count,
-	 -1 )
+	 "cerror_test_realloc_number_of_calls",
+	 cerror_test_realloc_number_of_calls,
+	 0 );
 
-#if defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY )
+	libcerror_error_free(
+	 &error );
 
-	/* Test libcerror_error_backtrace_sprint with memcpy returning NULL
+	/* Test that a back trace of 64 messages grows geometrically
 	 */
-	cerror_test_memcpy_attempts_before_fail = 0;
+	libcerror_pool_flush();
 
-	print_count = libcerror_error_backtrace_sprint(
-	               error,
-	               string,
-	               128 );
+	cerror_test_memory_start_accounting();
 
-	if( cerror_test_memcpy_attempts_before_fail != -1 )
-	{
-		cerror_test_memcpy_attempts_before_fail = -1;
-	}
-	else
+	for( error_index = 0;
+	     error_index < 64;
+	     error_index++ )
 	{
-		CERROR_TEST_ASSERT_EQUAL_INT(
-		 "print_count",
-		 print_count,
-		 -1 )
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "Test error: %d.",
+		 error_index );
 	}
-	libcerror_error_free(
-	  &error );
+	cerror_test_memory_stop_accounting();
 
-#endif /* defined( HAVE_CERROR_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED ) && defined( HAVE_NO_BUILTIN_MEMCPY ) */
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_malloc_number_of_calls",
+	 cerror_test_malloc_number_of_calls,
+	 1 );
 
-	/* Clean up
-	 */
-	libcerror_error_free(
-	  &error );
+	CERROR_TEST_ASSERT_LESS_THAN_INT(
+	 "cerror_test_realloc_number_of_calls",
+	 cerror_test_realloc_number_of_calls,
+	 8 );
 
-	CERROR_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	libcerror_error_free(
+	 &error );
 
 	return( 1 );
 
 on_error:
+	cerror_test_memory_stop_accounting();
+
 	if( error != NULL )
 	{
 		libcerror_error_free(
@@ -1729,6 +4622,8 @@ on_error:
 	return( 0 );
 }
 
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1750,12 +4645,20 @@ int main(
 	 "libcerror_error_initialize",
 	 cerror_test_error_initialize );
 
+	CERROR_TEST_RUN(
+	 "libcerror_error_initialize_reserve",
+	 cerror_test_error_initialize_reserve );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
 
 	CERROR_TEST_RUN(
 	 "libcerror_error_free",
 	 cerror_test_error_free );
 
+	CERROR_TEST_RUN(
+	 "libcerror_error_reset",
+	 cerror_test_error_reset );
+
 #if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
 
 	CERROR_TEST_RUN(
@@ -1776,10 +4679,30 @@ int main(
 	 "libcerror_error_set",
 	 cerror_test_error_set );
 
+	CERROR_TEST_RUN(
+	 "libcerror_error_set_static",
+	 cerror_test_error_set_static );
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_get_depth",
+	 cerror_test_error_get_depth );
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_truncate",
+	 cerror_test_error_truncate );
+
 	CERROR_TEST_RUN(
 	 "libcerror_error_matches",
 	 cerror_test_error_matches );
 
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_format_deferred_message",
+	 cerror_test_error_format_deferred_message );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
 	CERROR_TEST_RUN(
 	 "libcerror_error_fprint",
 	 cerror_test_error_fprint );
@@ -1788,6 +4711,10 @@ int main(
 	 "libcerror_error_backtrace_fprint",
 	 cerror_test_error_backtrace_fprint );
 
+	CERROR_TEST_RUN(
+	 "libcerror_error_backtrace_write_fd",
+	 cerror_test_error_backtrace_write_fd );
+
 	CERROR_TEST_RUN(
 	 "libcerror_error_sprint",
 	 cerror_test_error_sprint );
@@ -1796,6 +4723,42 @@ int main(
 	 "libcerror_error_backtrace_sprint",
 	 cerror_test_error_backtrace_sprint );
 
+	CERROR_TEST_RUN(
+	 "libcerror_error_backtrace_sprint_allocated",
+	 cerror_test_error_backtrace_sprint_allocated );
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_get_number_of_frames",
+	 cerror_test_error_get_number_of_frames );
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_get_frame_message",
+	 cerror_test_error_get_frame_message );
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_backtrace_visit",
+	 cerror_test_error_backtrace_visit );
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_backtrace_json_sprint",
+	 cerror_test_error_backtrace_json_sprint );
+
+	CERROR_TEST_RUN(
+	 "libcerror_error_backtrace_json_fprint",
+	 cerror_test_error_backtrace_json_fprint );
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#if defined( HAVE_CERROR_TEST_MEMORY )
+
+	CERROR_TEST_RUN(
+	 "allocation_budgets",
+	 cerror_test_error_allocation_budgets );
+
+#endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
+
 	return( EXIT_SUCCESS );
 
 on_error:
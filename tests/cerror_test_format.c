@@ -0,0 +1,581 @@
+/*
+ * Library format string functions testing program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_STDARG_H ) || defined( WINAPI )
+#include <stdarg.h>
+#elif defined( HAVE_VARARGS_H )
+#include <varargs.h>
+#else
+#error Missing headers stdarg.h and varargs.h
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+#include "../libcerror/libcerror_definitions.h"
+#include "../libcerror/libcerror_format.h"
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_STDARG_H )
+
+/* Packs the arguments of a format string and prints them to a string
+ * Returns the number of printed characters if successful or -1 on error
+ */
+int cerror_test_format_pack_and_print(
+     char *string,
+     size_t string_size,
+     const char *format_string,
+     ... )
+{
+	libcerror_format_scan_t scan;
+	uint8_t packed_data[ 1024 ];
+	va_list argument_list;
+
+	size_t packed_size = 0;
+	int result         = 0;
+
+	if( libcerror_format_scan(
+	     format_string,
+	     &scan ) != 1 )
+	{
+		return( -1 );
+	}
+	if( scan.number_of_arguments < 0 )
+	{
+		return( -1 );
+	}
+	va_start(
+	 argument_list,
+	 format_string );
+
+	result = libcerror_format_get_packed_size(
+	          &scan,
+	          argument_list,
+	          &packed_size );
+
+	va_end(
+	 argument_list );
+
+	if( ( result != 1 )
+	 || ( packed_size > 1024 ) )
+	{
+		return( -1 );
+	}
+	va_start(
+	 argument_list,
+	 format_string );
+
+	result = libcerror_format_pack(
+	          &scan,
+	          argument_list,
+	          packed_data,
+	          packed_size );
+
+	va_end(
+	 argument_list );
+
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( libcerror_format_print_packed(
+	         packed_data,
+	         packed_size,
+	         string,
+	         string_size ) );
+}
+
+/* Tests the libcerror_format_classify function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_format_classify(
+     void )
+{
+	libcerror_format_scan_t scan;
+
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_format_classify(
+	          "%s: invalid value %" PRIu64 " at offset: %" PRIzd " (0x%08" PRIx32 ") %*.*d %p %Lf %c %%.",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 10 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 0 ]",
+	 (int) scan.argument_types[ 0 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_STRING );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 2 ]",
+	 (int) scan.argument_types[ 2 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_SIZE );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 3 ]",
+	 (int) scan.argument_types[ 3 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_INT );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 4 ]",
+	 (int) scan.argument_types[ 4 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_INT );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 6 ]",
+	 (int) scan.argument_types[ 6 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_INT );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 7 ]",
+	 (int) scan.argument_types[ 7 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_POINTER );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 8 ]",
+	 (int) scan.argument_types[ 8 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_LONG_DOUBLE );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.argument_types[ 9 ]",
+	 (int) scan.argument_types[ 9 ],
+	 LIBCERROR_FORMAT_ARGUMENT_TYPE_INT );
+
+	/* Test format strings that cannot be deferred
+	 */
+	result = libcerror_format_classify(
+	          "%ls",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 -1 );
+
+	result = libcerror_format_classify(
+	          "%.4s",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 -1 );
+
+	result = libcerror_format_classify(
+	          "%-*.*s",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 -1 );
+
+	result = libcerror_format_classify(
+	          "%2$s %1$s",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 -1 );
+
+	result = libcerror_format_classify(
+	          "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 -1 );
+
+	result = libcerror_format_classify(
+	          "incomplete %",
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = libcerror_format_classify(
+	          NULL,
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_format_classify(
+	          "%d",
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libcerror_format_scan function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_format_scan(
+     void )
+{
+	libcerror_format_scan_t scan;
+
+	const char *format_string = "%s at offset: %" PRIi64 ".";
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_format_scan(
+	          format_string,
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 2 );
+
+	/* Test a cached classification
+	 */
+	result = libcerror_format_scan(
+	          format_string,
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "scan.number_of_arguments",
+	 scan.number_of_arguments,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libcerror_format_scan(
+	          NULL,
+	          &scan );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_format_scan(
+	          format_string,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libcerror_format_print_packed function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_format_print_packed(
+     void )
+{
+	char expected_string[ 256 ];
+	char string[ 256 ];
+	uint8_t packed_data[ 16 ];
+
+	const char *format_string = "%s: value: %5" PRIu64 " size: %" PRIzd " %-*s|%*.*d|%c %.3f %% %s";
+	int expected_print_count  = 0;
+	int print_count           = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	expected_print_count = narrow_string_snprintf(
+	                        expected_string,
+	                        256,
+	                        format_string,
+	                        "function",
+	                        (uint64_t) 42,
+	                        (size_t) 1024,
+	                        8,
+	                        "abcdef",
+	                        6,
+	                        4,
+	                        12,
+	                        'x',
+	                        1.5,
+	                        "end" );
+
+	print_count = cerror_test_format_pack_and_print(
+	               string,
+	               256,
+	               format_string,
+	               "function",
+	               (uint64_t) 42,
+	               (size_t) 1024,
+	               8,
+	               "abcdef",
+	               6,
+	               4,
+	               12,
+	               'x',
+	               1.5,
+	               "end" );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 expected_print_count );
+
+	result = narrow_string_compare(
+	          string,
+	          expected_string,
+	          (size_t) expected_print_count + 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a negative precision
+	 */
+	print_count = cerror_test_format_pack_and_print(
+	               string,
+	               256,
+	               "%.*d",
+	               -1,
+	               123 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 3 );
+
+	/* Test a truncated string
+	 */
+	print_count = cerror_test_format_pack_and_print(
+	               string,
+	               8,
+	               "%s %d",
+	               "truncated",
+	               12345 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 15 );
+
+	result = narrow_string_compare(
+	          string,
+	          "truncat",
+	          8 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	print_count = libcerror_format_print_packed(
+	               NULL,
+	               16,
+	               string,
+	               256 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	memory_set(
+	 packed_data,
+	 0,
+	 16 );
+
+	print_count = libcerror_format_print_packed(
+	               packed_data,
+	               0,
+	               string,
+	               256 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	print_count = libcerror_format_print_packed(
+	               packed_data,
+	               16,
+	               NULL,
+	               256 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	print_count = libcerror_format_print_packed(
+	               packed_data,
+	               16,
+	               string,
+	               0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	/* Test with a missing format string
+	 */
+	print_count = libcerror_format_print_packed(
+	               packed_data,
+	               16,
+	               string,
+	               256 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "print_count",
+	 print_count,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_STDARG_H ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_STDARG_H )
+
+	CERROR_TEST_RUN(
+	 "libcerror_format_classify",
+	 cerror_test_format_classify );
+
+	CERROR_TEST_RUN(
+	 "libcerror_format_scan",
+	 cerror_test_format_scan );
+
+	/* TODO: add tests for libcerror_format_get_packed_size */
+
+	/* TODO: add tests for libcerror_format_pack */
+
+	CERROR_TEST_RUN(
+	 "libcerror_format_print_packed",
+	 cerror_test_format_print_packed );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_STDARG_H ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_STDARG_H )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_STDARG_H ) */
+}
+
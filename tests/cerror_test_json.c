@@ -0,0 +1,548 @@
+/*
+ * Library JSON functions testing program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+#include "../libcerror/libcerror_json.h"
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+/* Tests the libcerror_json_get_utf8_sequence_size function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_json_get_utf8_sequence_size(
+     void )
+{
+	uint8_t string[ 8 ];
+
+	size_t sequence_size = 0;
+	int result           = 0;
+
+	/* Test regular cases
+	 */
+	string[ 0 ] = 0xc3;
+	string[ 1 ] = 0xa9;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          2,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "sequence_size",
+	 sequence_size,
+	 (size_t) 2 );
+
+	string[ 0 ] = 0xe2;
+	string[ 1 ] = 0x82;
+	string[ 2 ] = 0xac;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          3,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "sequence_size",
+	 sequence_size,
+	 (size_t) 3 );
+
+	string[ 0 ] = 0xf0;
+	string[ 1 ] = 0x9f;
+	string[ 2 ] = 0x98;
+	string[ 3 ] = 0x80;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          4,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "sequence_size",
+	 sequence_size,
+	 (size_t) 4 );
+
+	/* Test a truncated sequence
+	 */
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          3,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test an overlong sequence
+	 */
+	string[ 0 ] = 0xe0;
+	string[ 1 ] = 0x80;
+	string[ 2 ] = 0xaf;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          3,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a surrogate
+	 */
+	string[ 0 ] = 0xed;
+	string[ 1 ] = 0xa0;
+	string[ 2 ] = 0x80;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          3,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a code point beyond U+10FFFF
+	 */
+	string[ 0 ] = 0xf4;
+	string[ 1 ] = 0x90;
+	string[ 2 ] = 0x80;
+	string[ 3 ] = 0x80;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          4,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test an invalid continuation byte
+	 */
+	string[ 0 ] = 0xe2;
+	string[ 1 ] = 0x82;
+	string[ 2 ] = 0x41;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          3,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a byte that is not the first byte of a sequence
+	 */
+	string[ 0 ] = 0x80;
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          1,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libcerror_json_get_utf8_sequence_size(
+	          NULL,
+	          1,
+	          0,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          1,
+	          1,
+	          &sequence_size );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_json_get_utf8_sequence_size(
+	          string,
+	          1,
+	          0,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libcerror_json_get_escaped_string_length function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_json_get_escaped_string_length(
+     void )
+{
+	size_t escaped_string_length = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_json_get_escaped_string_length(
+	          (uint8_t *) "Test error.",
+	          11,
+	          &escaped_string_length );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "escaped_string_length",
+	 escaped_string_length,
+	 (size_t) 11 );
+
+	/* Test a quotation mark, a backslash, a new line, a control character,
+	 * a valid UTF-8 sequence and an invalid byte
+	 */
+	result = libcerror_json_get_escaped_string_length(
+	          (uint8_t *) "\"\\\n\x01\xc3\xa9\xff",
+	          7,
+	          &escaped_string_length );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "escaped_string_length",
+	 escaped_string_length,
+	 (size_t) 20 );
+
+	/* Test error cases
+	 */
+	result = libcerror_json_get_escaped_string_length(
+	          NULL,
+	          11,
+	          &escaped_string_length );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_json_get_escaped_string_length(
+	          (uint8_t *) "Test error.",
+	          11,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libcerror_json_escape_string function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_json_escape_string(
+     void )
+{
+	char escaped_string[ 64 ];
+
+	const char *expected_string = "\\\"\\\\\\n\\u0001\xc3\xa9\\ufffd";
+	const uint8_t *string       = (uint8_t *) "\"\\\n\x01\xc3\xa9\xff";
+	size_t escaped_string_index = 0;
+	size_t string_index         = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          &string_index,
+	          escaped_string,
+	          64,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "string_index",
+	 string_index,
+	 (size_t) 7 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "escaped_string_index",
+	 escaped_string_index,
+	 (size_t) 20 );
+
+	result = memory_compare(
+	          escaped_string,
+	          expected_string,
+	          20 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test escaping in parts, where an escape is not split
+	 */
+	escaped_string_index = 0;
+	string_index         = 0;
+
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          &string_index,
+	          escaped_string,
+	          9,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "string_index",
+	 string_index,
+	 (size_t) 3 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "escaped_string_index",
+	 escaped_string_index,
+	 (size_t) 6 );
+
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          &string_index,
+	          escaped_string,
+	          64,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_SIZE(
+	 "escaped_string_index",
+	 escaped_string_index,
+	 (size_t) 20 );
+
+	result = memory_compare(
+	          escaped_string,
+	          expected_string,
+	          20 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	escaped_string_index = 0;
+	string_index         = 0;
+
+	result = libcerror_json_escape_string(
+	          NULL,
+	          7,
+	          &string_index,
+	          escaped_string,
+	          64,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          NULL,
+	          escaped_string,
+	          64,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          &string_index,
+	          NULL,
+	          64,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          &string_index,
+	          escaped_string,
+	          64,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	escaped_string_index = 65;
+
+	result = libcerror_json_escape_string(
+	          string,
+	          7,
+	          &string_index,
+	          escaped_string,
+	          64,
+	          &escaped_string_index );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+	CERROR_TEST_RUN(
+	 "libcerror_json_get_utf8_sequence_size",
+	 cerror_test_json_get_utf8_sequence_size );
+
+	CERROR_TEST_RUN(
+	 "libcerror_json_get_escaped_string_length",
+	 cerror_test_json_get_escaped_string_length );
+
+	CERROR_TEST_RUN(
+	 "libcerror_json_escape_string",
+	 cerror_test_json_escape_string );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,366 @@
+/*
+ * Library error lifetime statistics functions test program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+#include "../libcerror/libcerror_definitions.h"
+
+/* Tests the libcerror_lifetime_get_lifetime_histogram, libcerror_lifetime_get_depth_histogram and libcerror_lifetime_reset functions
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_lifetime_get_histograms(
+     void )
+{
+	uint64_t depth_counts[ LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS ];
+	uint64_t lifetime_counts[ LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS ];
+
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_errors = 0;
+	int bucket_index          = 0;
+	int number_of_buckets     = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_lifetime_reset();
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 2 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 3 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_lifetime_get_lifetime_histogram(
+	          lifetime_counts,
+	          LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS,
+	          &number_of_buckets );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_buckets",
+		 number_of_buckets,
+		 LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS );
+
+		for( bucket_index = 0;
+		     bucket_index < number_of_buckets;
+		     bucket_index++ )
+		{
+			number_of_errors += lifetime_counts[ bucket_index ];
+		}
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_errors",
+		 number_of_errors,
+		 (uint64_t) 1 );
+
+		/* A depth of 3 is stored in the bucket of the depths of 2 up to 4
+		 */
+		result = libcerror_lifetime_get_depth_histogram(
+		          depth_counts,
+		          LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS,
+		          &number_of_buckets );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_buckets",
+		 number_of_buckets,
+		 LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "depth_counts[ 1 ]",
+		 depth_counts[ 1 ],
+		 (uint64_t) 0 );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "depth_counts[ 2 ]",
+		 depth_counts[ 2 ],
+		 (uint64_t) 1 );
+
+		/* Test a histogram with fewer buckets
+		 */
+		result = libcerror_lifetime_get_depth_histogram(
+		          depth_counts,
+		          2,
+		          &number_of_buckets );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_buckets",
+		 number_of_buckets,
+		 2 );
+
+		result = libcerror_lifetime_reset();
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libcerror_lifetime_get_depth_histogram(
+		          depth_counts,
+		          LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS,
+		          &number_of_buckets );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "depth_counts[ 2 ]",
+		 depth_counts[ 2 ],
+		 (uint64_t) 0 );
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_buckets",
+		 number_of_buckets,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_lifetime_get_lifetime_histogram(
+	          NULL,
+	          LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS,
+	          &number_of_buckets );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_lifetime_get_lifetime_histogram(
+	          lifetime_counts,
+	          -1,
+	          &number_of_buckets );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_lifetime_get_lifetime_histogram(
+	          lifetime_counts,
+	          LIBCERROR_LIFETIME_NUMBER_OF_LIFETIME_BUCKETS,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_lifetime_get_depth_histogram(
+	          NULL,
+	          LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS,
+	          &number_of_buckets );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_lifetime_get_depth_histogram(
+	          depth_counts,
+	          -1,
+	          &number_of_buckets );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_lifetime_get_depth_histogram(
+	          depth_counts,
+	          LIBCERROR_LIFETIME_NUMBER_OF_DEPTH_BUCKETS,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_lifetime_fprint function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_lifetime_fprint(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	FILE *stream             = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error." );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libcerror_lifetime_fprint(
+	          stream );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+		 "ftell",
+		 (int) ftell( stream ),
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_lifetime_fprint(
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	fclose(
+	 stream );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CERROR_TEST_RUN(
+	 "libcerror_lifetime_get_lifetime_histogram",
+	 cerror_test_lifetime_get_histograms );
+
+	CERROR_TEST_RUN(
+	 "libcerror_lifetime_fprint",
+	 cerror_test_lifetime_fprint );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
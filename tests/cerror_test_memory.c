@@ -35,6 +35,47 @@
 
 #if defined( HAVE_CERROR_TEST_MEMORY )
 
+/* Value to indicate the calls and bytes of the memory functions are counted
+ */
+int cerror_test_memory_accounting = 0;
+
+int cerror_test_malloc_number_of_calls    = 0;
+size_t cerror_test_malloc_number_of_bytes = 0;
+
+int cerror_test_memcpy_number_of_calls    = 0;
+size_t cerror_test_memcpy_number_of_bytes = 0;
+
+int cerror_test_memset_number_of_calls    = 0;
+size_t cerror_test_memset_number_of_bytes = 0;
+
+int cerror_test_realloc_number_of_calls    = 0;
+size_t cerror_test_realloc_number_of_bytes = 0;
+
+/* Starts counting the calls and bytes of the memory functions
+ */
+void cerror_test_memory_start_accounting(
+      void )
+{
+	cerror_test_malloc_number_of_calls  = 0;
+	cerror_test_malloc_number_of_bytes  = 0;
+	cerror_test_memcpy_number_of_calls  = 0;
+	cerror_test_memcpy_number_of_bytes  = 0;
+	cerror_test_memset_number_of_calls  = 0;
+	cerror_test_memset_number_of_bytes  = 0;
+	cerror_test_realloc_number_of_calls = 0;
+	cerror_test_realloc_number_of_bytes = 0;
+
+	cerror_test_memory_accounting = 1;
+}
+
+/* Stops counting the calls and bytes of the memory functions
+ */
+void cerror_test_memory_stop_accounting(
+      void )
+{
+	cerror_test_memory_accounting = 0;
+}
+
 static void *(*cerror_test_real_malloc)(size_t) = NULL;
 int cerror_test_malloc_attempts_before_fail     = -1;
 
@@ -58,6 +99,11 @@ void *malloc(
 			return( NULL );
 		}
 	}
+	if( cerror_test_memory_accounting != 0 )
+	{
+		cerror_test_malloc_number_of_calls += 1;
+		cerror_test_malloc_number_of_bytes += size;
+	}
 	if( cerror_test_malloc_attempts_before_fail == 0 )
 	{
 		cerror_test_malloc_attempts_before_fail = -1;
@@ -97,6 +143,11 @@ void *memcpy(
 			return( NULL );
 		}
 	}
+	if( cerror_test_memory_accounting != 0 )
+	{
+		cerror_test_memcpy_number_of_calls += 1;
+		cerror_test_memcpy_number_of_bytes += size;
+	}
 	if( cerror_test_memcpy_attempts_before_fail == 0 )
 	{
 		cerror_test_memcpy_attempts_before_fail = -1;
@@ -138,6 +189,11 @@ void *memset(
 			return( NULL );
 		}
 	}
+	if( cerror_test_memory_accounting != 0 )
+	{
+		cerror_test_memset_number_of_calls += 1;
+		cerror_test_memset_number_of_bytes += size;
+	}
 	if( cerror_test_memset_attempts_before_fail == 0 )
 	{
 		cerror_test_memset_attempts_before_fail = -1;
@@ -178,6 +234,11 @@ void *realloc(
 			return( NULL );
 		}
 	}
+	if( cerror_test_memory_accounting != 0 )
+	{
+		cerror_test_realloc_number_of_calls += 1;
+		cerror_test_realloc_number_of_bytes += size;
+	}
 	if( cerror_test_realloc_attempts_before_fail == 0 )
 	{
 		cerror_test_realloc_attempts_before_fail = -1;
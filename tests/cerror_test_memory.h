@@ -56,6 +56,30 @@ extern int cerror_test_memset_attempts_before_fail;
 
 extern int cerror_test_realloc_attempts_before_fail;
 
+extern int cerror_test_memory_accounting;
+
+extern int cerror_test_malloc_number_of_calls;
+
+extern size_t cerror_test_malloc_number_of_bytes;
+
+extern int cerror_test_memcpy_number_of_calls;
+
+extern size_t cerror_test_memcpy_number_of_bytes;
+
+extern int cerror_test_memset_number_of_calls;
+
+extern size_t cerror_test_memset_number_of_bytes;
+
+extern int cerror_test_realloc_number_of_calls;
+
+extern size_t cerror_test_realloc_number_of_bytes;
+
+void cerror_test_memory_start_accounting(
+      void );
+
+void cerror_test_memory_stop_accounting(
+      void );
+
 #endif /* defined( HAVE_CERROR_TEST_MEMORY ) */
 
 #if defined( __cplusplus )
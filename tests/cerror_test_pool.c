@@ -0,0 +1,418 @@
+/*
+ * Library error pool functions test program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+#include "../libcerror/libcerror_definitions.h"
+#include "../libcerror/libcerror_pool.h"
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+/* Tests the libcerror_pool_get_block and libcerror_pool_put_block functions
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_pool_get_block(
+     void )
+{
+	void *block        = NULL;
+	void *pooled_block = NULL;
+	int result         = 0;
+	int pool_result    = 0;
+
+	libcerror_pool_flush();
+
+	/* Test regular cases
+	 */
+	pooled_block = libcerror_pool_get_block();
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "pooled_block",
+	 pooled_block );
+
+	block = memory_allocate(
+	         LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "block",
+	 block );
+
+	pool_result = libcerror_pool_put_block(
+	               block,
+	               LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "pool_result",
+	 pool_result,
+	 -1 );
+
+	if( pool_result == 1 )
+	{
+		pooled_block = libcerror_pool_get_block();
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "pooled_block == block",
+		 (int) ( pooled_block == block ),
+		 1 );
+
+		pool_result = libcerror_pool_put_block(
+		               block,
+		               LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "pool_result",
+		 pool_result,
+		 1 );
+
+		/* The block is freed by the flush
+		 */
+		block = NULL;
+
+		libcerror_pool_flush();
+
+		pooled_block = libcerror_pool_get_block();
+
+		CERROR_TEST_ASSERT_IS_NULL(
+		 "pooled_block",
+		 pooled_block );
+	}
+	else
+	{
+		memory_free(
+		 block );
+
+		block = NULL;
+	}
+	/* Test a block that exceeds the largest size class
+	 */
+	block = memory_allocate(
+	         LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "block",
+	 block );
+
+	result = libcerror_pool_put_block(
+	          block,
+	          (size_t) SSIZE_MAX );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_free(
+	 block );
+
+	block = NULL;
+
+	/* Test error cases
+	 */
+	result = libcerror_pool_put_block(
+	          NULL,
+	          LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( block != NULL )
+	{
+		memory_free(
+		 block );
+	}
+	libcerror_pool_flush();
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+
+/* Tests the libcerror_pool_get_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_pool_get_statistics(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	uint64_t number_of_hits         = 0;
+	uint64_t number_of_kept_returns = 0;
+	uint64_t number_of_requests     = 0;
+	uint64_t number_of_returns      = 0;
+	uint64_t previous_hits          = 0;
+	uint64_t previous_requests      = 0;
+	int error_index                 = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_pool_get_statistics(
+	          &previous_requests,
+	          &previous_hits,
+	          &number_of_returns,
+	          &number_of_kept_returns );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	for( error_index = 0;
+	     error_index < 2;
+	     error_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "Test error %d.",
+		 error_index );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	result = libcerror_pool_get_statistics(
+	          &number_of_requests,
+	          &number_of_hits,
+	          &number_of_returns,
+	          &number_of_kept_returns );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_requests",
+		 number_of_requests,
+		 previous_requests + 2 );
+
+		/* The second error reuses the block of the first error
+		 */
+		CERROR_TEST_ASSERT_LESS_THAN_UINT64(
+		 "previous_hits",
+		 previous_hits,
+		 number_of_hits );
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_requests",
+		 number_of_requests,
+		 (uint64_t) 0 );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_pool_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_returns,
+	          &number_of_kept_returns );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_pool_get_statistics(
+	          &number_of_requests,
+	          NULL,
+	          &number_of_returns,
+	          &number_of_kept_returns );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_pool_get_statistics(
+	          &number_of_requests,
+	          &number_of_hits,
+	          NULL,
+	          &number_of_kept_returns );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_pool_get_statistics(
+	          &number_of_requests,
+	          &number_of_hits,
+	          &number_of_returns,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+
+/* Tests the libcerror_pool_finalize function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_pool_finalize(
+     void )
+{
+	void *block = NULL;
+	int result  = 0;
+
+	/* Initialize test
+	 */
+	block = memory_allocate(
+	         LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "block",
+	 block );
+
+	result = libcerror_pool_put_block(
+	          block,
+	          LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	if( result != 1 )
+	{
+		memory_free(
+		 block );
+	}
+	block = NULL;
+
+	/* Test regular cases
+	 */
+	libcerror_pool_finalize();
+
+	block = libcerror_pool_get_block();
+
+	CERROR_TEST_ASSERT_IS_NULL(
+	 "block",
+	 block );
+
+	/* Blocks are no longer kept in the pool after the library was finalized
+	 */
+	block = memory_allocate(
+	         LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "block",
+	 block );
+
+	result = libcerror_pool_put_block(
+	          block,
+	          LIBCERROR_POOL_SMALLEST_SIZE_CLASS );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_free(
+	 block );
+
+	return( 1 );
+
+on_error:
+	if( block != NULL )
+	{
+		memory_free(
+		 block );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT )
+
+	CERROR_TEST_RUN(
+	 "libcerror_pool_get_block",
+	 cerror_test_pool_get_block );
+
+	/* TODO: add tests for libcerror_pool_flush */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) */
+
+	CERROR_TEST_RUN(
+	 "libcerror_pool_get_statistics",
+	 cerror_test_pool_get_statistics );
+
+#if defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL )
+
+	/* The pool cannot be used after libcerror_pool_finalize hence it is tested last
+	 */
+	CERROR_TEST_RUN(
+	 "libcerror_pool_finalize",
+	 cerror_test_pool_finalize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBCERROR_DLL_IMPORT ) && defined( HAVE_ERROR_POOL ) && defined( LIBCERROR_THREAD_LOCAL ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
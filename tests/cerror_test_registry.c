@@ -0,0 +1,304 @@
+/*
+ * Library live error registry functions test program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+/* Tests the libcerror_get_number_of_live_errors function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_get_number_of_live_errors(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	int message_index                  = 0;
+	int number_of_live_errors          = 0;
+	int previous_number_of_live_errors = 0;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_get_number_of_live_errors(
+	          &previous_number_of_live_errors );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Add enough messages for the error to be reallocated
+	 */
+	for( message_index = 0;
+	     message_index < 64;
+	     message_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "Test error %d.",
+		 message_index );
+	}
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	result = libcerror_get_number_of_live_errors(
+	          &number_of_live_errors );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_live_errors",
+		 number_of_live_errors,
+		 previous_number_of_live_errors + 1 );
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_live_errors",
+		 number_of_live_errors,
+		 0 );
+	}
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_get_number_of_live_errors(
+	          &number_of_live_errors );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_live_errors",
+		 number_of_live_errors,
+		 previous_number_of_live_errors );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_get_number_of_live_errors(
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_dump_live_errors function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_dump_live_errors(
+     void )
+{
+	char buffer[ 4096 ];
+
+	libcerror_error_t *error = NULL;
+	FILE *stream             = NULL;
+	size_t read_count        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	LIBCERROR_ERROR_SET_AT(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcerror_dump_live_errors(
+	          stream );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		/* The live error is reported with the call site that created it
+		 */
+		result = fseek(
+		          stream,
+		          0,
+		          SEEK_SET );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		read_count = fread(
+		              buffer,
+		              1,
+		              4095,
+		              stream );
+
+		buffer[ read_count ] = 0;
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "file",
+		 narrow_string_search_string(
+		  buffer,
+		  "cerror_test_registry.c:",
+		  read_count ) );
+	}
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libcerror_dump_live_errors(
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	fclose(
+	 stream );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_dump_live_errors_at_exit function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_dump_live_errors_at_exit(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_dump_live_errors_at_exit(
+	          stderr );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_dump_live_errors_at_exit(
+	          NULL );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CERROR_TEST_RUN(
+	 "libcerror_get_number_of_live_errors",
+	 cerror_test_get_number_of_live_errors );
+
+	CERROR_TEST_RUN(
+	 "libcerror_dump_live_errors",
+	 cerror_test_dump_live_errors );
+
+	CERROR_TEST_RUN(
+	 "libcerror_dump_live_errors_at_exit",
+	 cerror_test_dump_live_errors_at_exit );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,787 @@
+/*
+ * Library error statistics functions test program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+#include "../libcerror/libcerror_definitions.h"
+
+/* Tests the libcerror_statistics_get_count function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_statistics_get_count(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t count           = 0;
+	uint64_t previous_count  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_statistics_get_count(
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_IO_ERROR_READ_FAILED,
+	          &previous_count );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 2 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_statistics_get_count(
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_IO_ERROR_READ_FAILED,
+	          &count );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "count",
+		 count,
+		 previous_count + 2 );
+	}
+	else
+	{
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "count",
+		 count,
+		 (uint64_t) 0 );
+	}
+	/* Test an error code that is counted as other error code
+	 */
+	result = libcerror_statistics_get_count(
+	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	          -1,
+	          &previous_count );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 1024,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_statistics_get_count(
+	          LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	          -1,
+	          &count );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "count",
+		 count,
+		 previous_count + 1 );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_statistics_get_count(
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_IO_ERROR_READ_FAILED,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_count(
+	          LIBCERROR_ERROR_DOMAIN_IO,
+	          LIBCERROR_STATISTICS_NUMBER_OF_CODES,
+	          &count );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcerror_statistics_get_count(
+	          (int) 'X',
+	          LIBCERROR_IO_ERROR_READ_FAILED,
+	          &count );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_statistics_get_snapshot and libcerror_statistics_reset functions
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_statistics_get_snapshot(
+     void )
+{
+	int error_codes[ 4 ];
+	int error_domains[ 4 ];
+	uint64_t counts[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	int number_of_entries    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_statistics_reset();
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+	 "Test error." );
+
+	libcerror_error_set_static(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcerror_statistics_get_snapshot(
+	          error_domains,
+	          error_codes,
+	          counts,
+	          4,
+	          &number_of_entries );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_entries",
+		 number_of_entries,
+		 2 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "error_domains[ 0 ]",
+		 error_domains[ 0 ],
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "error_codes[ 0 ]",
+		 error_codes[ 0 ],
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "counts[ 0 ]",
+		 counts[ 0 ],
+		 (uint64_t) 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "error_domains[ 1 ]",
+		 error_domains[ 1 ],
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "error_codes[ 1 ]",
+		 error_codes[ 1 ],
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "counts[ 1 ]",
+		 counts[ 1 ],
+		 (uint64_t) 2 );
+
+		/* Test a snapshot with fewer entries than counters
+		 */
+		result = libcerror_statistics_get_snapshot(
+		          error_domains,
+		          error_codes,
+		          counts,
+		          1,
+		          &number_of_entries );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "number_of_entries",
+		 number_of_entries,
+		 1 );
+
+		result = libcerror_statistics_reset();
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libcerror_statistics_get_snapshot(
+		          error_domains,
+		          error_codes,
+		          counts,
+		          4,
+		          &number_of_entries );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libcerror_statistics_get_snapshot(
+	          NULL,
+	          error_codes,
+	          counts,
+	          4,
+	          &number_of_entries );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_snapshot(
+	          error_domains,
+	          NULL,
+	          counts,
+	          4,
+	          &number_of_entries );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_snapshot(
+	          error_domains,
+	          error_codes,
+	          NULL,
+	          4,
+	          &number_of_entries );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_snapshot(
+	          error_domains,
+	          error_codes,
+	          counts,
+	          -1,
+	          &number_of_entries );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_snapshot(
+	          error_domains,
+	          error_codes,
+	          counts,
+	          4,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_statistics_get_message_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_statistics_get_message_statistics(
+     void )
+{
+	char long_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE + 16 ];
+
+	libcerror_error_t *error              = NULL;
+	uint64_t allocated_message_data_size  = 0;
+	uint64_t number_of_truncated_messages = 0;
+	int maximum_depth                     = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libcerror_statistics_reset();
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	memory_set(
+	 long_string,
+	 'A',
+	 LIBCERROR_MESSAGE_MAXIMUM_SIZE + 15 );
+
+	long_string[ LIBCERROR_MESSAGE_MAXIMUM_SIZE + 15 ] = 0;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error." );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "%s",
+	 long_string );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error: %d.",
+	 3 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libcerror_statistics_get_message_statistics(
+	          &allocated_message_data_size,
+	          &maximum_depth,
+	          &number_of_truncated_messages );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "maximum_depth",
+		 maximum_depth,
+		 3 );
+
+		CERROR_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_truncated_messages",
+		 number_of_truncated_messages,
+		 (uint64_t) 1 );
+
+		result = libcerror_statistics_reset();
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libcerror_statistics_get_message_statistics(
+		          &allocated_message_data_size,
+		          &maximum_depth,
+		          &number_of_truncated_messages );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	CERROR_TEST_ASSERT_EQUAL_UINT64(
+	 "allocated_message_data_size",
+	 allocated_message_data_size,
+	 (uint64_t) 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "maximum_depth",
+	 maximum_depth,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_truncated_messages",
+	 number_of_truncated_messages,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libcerror_statistics_get_message_statistics(
+	          NULL,
+	          &maximum_depth,
+	          &number_of_truncated_messages );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_message_statistics(
+	          &allocated_message_data_size,
+	          NULL,
+	          &number_of_truncated_messages );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_statistics_get_message_statistics(
+	          &allocated_message_data_size,
+	          &maximum_depth,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_statistics_write_prometheus function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_statistics_write_prometheus(
+     void )
+{
+	char buffer[ 4096 ];
+
+	libcerror_error_t *error = NULL;
+	FILE *stream             = NULL;
+	size_t read_count        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	stream = tmpfile();
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	result = libcerror_statistics_reset();
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error." );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libcerror_statistics_write_prometheus(
+	          stream );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		result = fseek(
+		          stream,
+		          0,
+		          SEEK_SET );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		read_count = fread(
+		              buffer,
+		              1,
+		              4095,
+		              stream );
+
+		buffer[ read_count ] = 0;
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "errors_total",
+		 narrow_string_search_string(
+		  buffer,
+		  "libcerror_errors_total{domain=\"io\",code=\"4\"} 1\n",
+		  read_count ) );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "domain_errors_total",
+		 narrow_string_search_string(
+		  buffer,
+		  "libcerror_domain_errors_total{domain=\"io\"} 1\n",
+		  read_count ) );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error_maximum_depth",
+		 narrow_string_search_string(
+		  buffer,
+		  "libcerror_error_maximum_depth 1\n",
+		  read_count ) );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_statistics_write_prometheus(
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	fclose(
+	 stream );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* Tests the libcerror_statistics_write_prometheus_file function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_statistics_write_prometheus_file(
+     void )
+{
+	FILE *stream = NULL;
+	int result   = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_statistics_write_prometheus_file(
+	          "cerror_test_statistics.prom" );
+
+	CERROR_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		stream = fopen(
+		          "cerror_test_statistics.prom",
+		          "r" );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "stream",
+		 stream );
+
+		fclose(
+		 stream );
+
+		stream = NULL;
+
+		/* The temporary file is renamed
+		 */
+		stream = fopen(
+		          "cerror_test_statistics.prom.tmp",
+		          "r" );
+
+		CERROR_TEST_ASSERT_IS_NULL(
+		 "stream",
+		 stream );
+
+		remove(
+		 "cerror_test_statistics.prom" );
+	}
+	/* Test error cases
+	 */
+	result = libcerror_statistics_write_prometheus_file(
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		fclose(
+		 stream );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CERROR_TEST_RUN(
+	 "libcerror_statistics_get_count",
+	 cerror_test_statistics_get_count );
+
+	CERROR_TEST_RUN(
+	 "libcerror_statistics_get_snapshot",
+	 cerror_test_statistics_get_snapshot );
+
+	CERROR_TEST_RUN(
+	 "libcerror_statistics_get_message_statistics",
+	 cerror_test_statistics_get_message_statistics );
+
+	CERROR_TEST_RUN(
+	 "libcerror_statistics_write_prometheus",
+	 cerror_test_statistics_write_prometheus );
+
+	CERROR_TEST_RUN(
+	 "libcerror_statistics_write_prometheus_file",
+	 cerror_test_statistics_write_prometheus_file );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <types.h>
 
@@ -28,10 +29,152 @@
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
 #include "cerror_test_libcerror.h"
 #include "cerror_test_macros.h"
 #include "cerror_test_unused.h"
 
+/* The memory blocks allocated by the test memory functions
+ */
+static void *cerror_test_memory_blocks[ 64 ];
+
+static int cerror_test_number_of_memory_blocks = 0;
+
+/* The number of calls of the test memory functions and the number of frees of blocks
+ * that were not allocated by the test memory functions
+ */
+static int cerror_test_number_of_allocations   = 0;
+static int cerror_test_number_of_reallocations = 0;
+static int cerror_test_number_of_frees         = 0;
+static int cerror_test_number_of_foreign_frees = 0;
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+
+/* The state of the test thread, which is protected by the mutex
+ * 0 the thread is starting, 1 the thread has freed its errors,
+ * 2 the memory functions are set and 3 the thread has finished its tests
+ */
+static pthread_mutex_t cerror_test_thread_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cerror_test_thread_cond   = PTHREAD_COND_INITIALIZER;
+
+static int cerror_test_thread_state             = 0;
+
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
+/* Removes a memory block from the test memory blocks
+ * Returns 1 if successful or 0 if the memory block was not allocated by the test memory functions
+ */
+int cerror_test_remove_memory_block(
+     void *memory )
+{
+	int block_index = 0;
+
+	for( block_index = 0;
+	     block_index < cerror_test_number_of_memory_blocks;
+	     block_index++ )
+	{
+		if( cerror_test_memory_blocks[ block_index ] == memory )
+		{
+			cerror_test_number_of_memory_blocks -= 1;
+
+			cerror_test_memory_blocks[ block_index ] = cerror_test_memory_blocks[ cerror_test_number_of_memory_blocks ];
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Test memory allocate function
+ * Returns a pointer to the allocated memory or NULL on error
+ */
+void *cerror_test_allocate(
+       size_t size,
+       void *context )
+{
+	void *memory = NULL;
+
+	if( ( context != (void *) &cerror_test_memory_blocks )
+	 || ( cerror_test_number_of_memory_blocks >= 64 ) )
+	{
+		return( NULL );
+	}
+	memory = memory_allocate(
+	          size );
+
+	if( memory != NULL )
+	{
+		cerror_test_memory_blocks[ cerror_test_number_of_memory_blocks++ ] = memory;
+	}
+	cerror_test_number_of_allocations += 1;
+
+	return( memory );
+}
+
+/* Test memory reallocate function
+ * Returns a pointer to the reallocated memory or NULL on error
+ */
+void *cerror_test_reallocate(
+       void *memory,
+       size_t size,
+       void *context )
+{
+	void *reallocation = NULL;
+
+	if( context != (void *) &cerror_test_memory_blocks )
+	{
+		return( NULL );
+	}
+	if( cerror_test_remove_memory_block(
+	     memory ) != 1 )
+	{
+		cerror_test_number_of_foreign_frees += 1;
+
+		return( NULL );
+	}
+	reallocation = memory_reallocate(
+	                memory,
+	                size );
+
+	if( reallocation == NULL )
+	{
+		cerror_test_memory_blocks[ cerror_test_number_of_memory_blocks++ ] = memory;
+	}
+	else
+	{
+		cerror_test_memory_blocks[ cerror_test_number_of_memory_blocks++ ] = reallocation;
+	}
+	cerror_test_number_of_reallocations += 1;
+
+	return( reallocation );
+}
+
+/* Test memory free function
+ */
+void cerror_test_free(
+      void *memory,
+      void *context )
+{
+	if( context != (void *) &cerror_test_memory_blocks )
+	{
+		return;
+	}
+	if( cerror_test_remove_memory_block(
+	     memory ) != 1 )
+	{
+		cerror_test_number_of_foreign_frees += 1;
+
+		return;
+	}
+	memory_free(
+	 memory );
+
+	cerror_test_number_of_frees += 1;
+}
+
 /* Tests the libcerror_get_version function
  * Returns 1 if successful or 0 if not
  */
@@ -59,6 +202,428 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libcerror_set_deferred_formatting function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_set_deferred_formatting(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_set_deferred_formatting(
+	          0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcerror_set_deferred_formatting(
+	          1 );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+#else
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+#endif
+
+	/* Clean up
+	 */
+	result = libcerror_set_deferred_formatting(
+	          0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	libcerror_set_deferred_formatting(
+	 0 );
+
+	return( 0 );
+}
+
+/* Tests the libcerror_set_memory_functions function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_set_memory_functions(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int error_index          = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_set_memory_functions(
+	          &cerror_test_allocate,
+	          &cerror_test_reallocate,
+	          &cerror_test_free,
+	          (void *) &cerror_test_memory_blocks );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Set enough messages to require the error to be resized
+	 */
+	for( error_index = 0;
+	     error_index < 16;
+	     error_index++ )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "Test error %d.",
+		 error_index );
+
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+	}
+	libcerror_system_set_error(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 0,
+	 "Test system error." );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The errors are not kept in the pool while the memory functions are set
+	 */
+	result = libcerror_set_memory_functions(
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_allocations",
+	 cerror_test_number_of_allocations,
+	 0 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_reallocations",
+	 cerror_test_number_of_reallocations,
+	 0 );
+
+	CERROR_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_frees",
+	 cerror_test_number_of_frees,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_foreign_frees",
+	 cerror_test_number_of_foreign_frees,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_memory_blocks",
+	 cerror_test_number_of_memory_blocks,
+	 0 );
+
+	/* Errors created with the default memory functions do not use the test memory functions
+	 */
+	cerror_test_number_of_allocations = 0;
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_allocations",
+	 cerror_test_number_of_allocations,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libcerror_set_memory_functions(
+	          NULL,
+	          &cerror_test_reallocate,
+	          &cerror_test_free,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_set_memory_functions(
+	          &cerror_test_allocate,
+	          NULL,
+	          &cerror_test_free,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_set_memory_functions(
+	          &cerror_test_allocate,
+	          &cerror_test_reallocate,
+	          NULL,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcerror_set_memory_functions(
+	          NULL,
+	          NULL,
+	          NULL,
+	          (void *) &cerror_test_memory_blocks );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libcerror_set_memory_functions(
+	 NULL,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( 0 );
+}
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+
+/* Sets the state of the test thread
+ */
+void cerror_test_set_thread_state(
+      int state )
+{
+	pthread_mutex_lock(
+	 &cerror_test_thread_mutex );
+
+	cerror_test_thread_state = state;
+
+	pthread_cond_broadcast(
+	 &cerror_test_thread_cond );
+
+	pthread_mutex_unlock(
+	 &cerror_test_thread_mutex );
+}
+
+/* Waits for the state of the test thread
+ */
+void cerror_test_wait_for_thread_state(
+      int state )
+{
+	pthread_mutex_lock(
+	 &cerror_test_thread_mutex );
+
+	while( cerror_test_thread_state < state )
+	{
+		pthread_cond_wait(
+		 &cerror_test_thread_cond,
+		 &cerror_test_thread_mutex );
+	}
+	pthread_mutex_unlock(
+	 &cerror_test_thread_mutex );
+}
+
+/* Test thread that frees errors before the memory functions are set
+ * and sets an error after the memory functions are set
+ * Returns NULL
+ */
+void *cerror_test_set_memory_functions_thread(
+       void *arguments CERROR_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *errors[ 4 ] = { NULL, NULL, NULL, NULL };
+	libcerror_error_t *error       = NULL;
+	int error_index                = 0;
+
+	CERROR_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	/* Keep errors allocated with the default memory functions in the pool of this thread
+	 */
+	for( error_index = 0;
+	     error_index < 4;
+	     error_index++ )
+	{
+		libcerror_error_set(
+		 &( errors[ error_index ] ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "Test error %d.",
+		 error_index );
+	}
+	for( error_index = 0;
+	     error_index < 4;
+	     error_index++ )
+	{
+		libcerror_error_free(
+		 &( errors[ error_index ] ) );
+	}
+	cerror_test_set_thread_state(
+	 1 );
+
+	cerror_test_wait_for_thread_state(
+	 2 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+	 "Test error." );
+
+	libcerror_error_free(
+	 &error );
+
+	cerror_test_set_thread_state(
+	 3 );
+
+	/* The errors in the pool of this thread are freed on exit
+	 */
+	return( NULL );
+}
+
+/* Tests the libcerror_set_memory_functions function with errors in the pool of another thread
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_set_memory_functions_with_thread(
+     void )
+{
+	pthread_t thread;
+
+	int result = 0;
+
+	/* Initialize test
+	 */
+	cerror_test_number_of_allocations   = 0;
+	cerror_test_number_of_frees         = 0;
+	cerror_test_number_of_foreign_frees = 0;
+	cerror_test_thread_state            = 0;
+
+	result = pthread_create(
+	          &thread,
+	          NULL,
+	          &cerror_test_set_memory_functions_thread,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	cerror_test_wait_for_thread_state(
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libcerror_set_memory_functions(
+	          &cerror_test_allocate,
+	          &cerror_test_reallocate,
+	          &cerror_test_free,
+	          (void *) &cerror_test_memory_blocks );
+
+	cerror_test_set_thread_state(
+	 2 );
+
+	cerror_test_wait_for_thread_state(
+	 3 );
+
+	pthread_join(
+	 thread,
+	 NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The error of the thread is allocated and freed with the test memory functions
+	 * and the errors in its pool are not freed with the test memory functions
+	 */
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_allocations",
+	 cerror_test_number_of_allocations,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_frees",
+	 cerror_test_number_of_frees,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_foreign_frees",
+	 cerror_test_number_of_foreign_frees,
+	 0 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "number_of_memory_blocks",
+	 cerror_test_number_of_memory_blocks,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libcerror_set_memory_functions(
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	libcerror_set_memory_functions(
+	 NULL,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -78,6 +643,20 @@ int main(
 	 "libcerror_get_version",
 	 cerror_test_get_version );
 
+	CERROR_TEST_RUN(
+	 "libcerror_set_deferred_formatting",
+	 cerror_test_set_deferred_formatting );
+
+	CERROR_TEST_RUN(
+	 "libcerror_set_memory_functions",
+	 cerror_test_set_memory_functions );
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+	CERROR_TEST_RUN(
+	 "libcerror_set_memory_functions with thread",
+	 cerror_test_set_memory_functions_with_thread );
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -47,6 +47,7 @@
 
 #include "../libcerror/libcerror_definitions.h"
 #include "../libcerror/libcerror_error.h"
+#include "../libcerror/libcerror_pool.h"
 #include "../libcerror/libcerror_system.h"
 
 #if defined( HAVE_CERROR_TEST_FUNCTION_HOOK )
@@ -472,9 +473,16 @@ on_error:
 int cerror_test_system_set_error(
      void )
 {
-	libcerror_error_t *error         = NULL;
-	system_character_t *error_string = NULL;
-	uint32_t error_code              = 0;
+	libcerror_error_t *error = NULL;
+	uint32_t error_code      = 0;
+
+#if defined( HAVE_CERROR_TEST_MEMORY )
+	char long_string[ 2048 ];
+
+	libcerror_internal_error_t *internal_error = NULL;
+	size_t message_size                        = 0;
+	int result                                 = 0;
+#endif
 
 	/* Test regular cases
 	 */
@@ -571,15 +579,8 @@ int cerror_test_system_set_error(
 	 "error",
 	 error );
 
-	error_string = ( (libcerror_internal_error_t *) error )->messages[ 0 ];
-
 	( (libcerror_internal_error_t *) error )->messages[ 0 ] = NULL;
 
-	memory_free(
-	 error_string );
-
-	error_string = NULL;
-
 	libcerror_system_set_error(
 	 &error,
 	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
@@ -627,7 +628,10 @@ int cerror_test_system_set_error(
 #if defined( HAVE_CERROR_TEST_MEMORY )
 
 	/* Test libcerror_system_set_error with libcerror_error_initialize failing
+	 * which falls back to the reserve error
 	 */
+	libcerror_pool_flush();
+
 	cerror_test_malloc_attempts_before_fail = 0;
 
 	libcerror_system_set_error(
@@ -643,10 +647,24 @@ int cerror_test_system_set_error(
 	}
 	else
 	{
+#if defined( LIBCERROR_THREAD_LOCAL )
+		CERROR_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "is_reserve",
+		 ( (libcerror_internal_error_t *) error )->is_reserve,
+		 1 );
+#else
 		CERROR_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
+#endif
 	}
+	libcerror_error_free(
+	  &error );
+
 	/* Test libcerror_system_set_error with libcerror_error_resize failing
 	 */
 	cerror_test_realloc_attempts_before_fail = 0;
@@ -671,6 +689,70 @@ int cerror_test_system_set_error(
 	libcerror_error_free(
 	  &error );
 
+	/* Test libcerror_system_set_error with libcerror_error_resize failing
+	 * which truncates the message into the remaining message data
+	 */
+	libcerror_system_set_error(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 error_code,
+	 "Test error." );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 long_string,
+	 'A',
+	 2047 );
+
+	long_string[ 2047 ] = 0;
+
+	cerror_test_realloc_attempts_before_fail = 0;
+
+	libcerror_system_set_error(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 error_code,
+	 "%s",
+	 long_string );
+
+	if( cerror_test_realloc_attempts_before_fail != -1 )
+	{
+		cerror_test_realloc_attempts_before_fail = -1;
+	}
+	else
+	{
+		internal_error = (libcerror_internal_error_t *) error;
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "internal_error->number_of_messages",
+		 internal_error->number_of_messages,
+		 2 );
+
+		CERROR_TEST_ASSERT_EQUAL_SIZE(
+		 "internal_error->message_data_size",
+		 internal_error->message_data_size,
+		 internal_error->allocated_message_data_size );
+
+		message_size = internal_error->sizes[ 1 ];
+
+		result = system_string_compare(
+		          &( internal_error->messages[ 1 ][ message_size - 4 ] ),
+		          _SYSTEM_STRING( "..." ),
+		          4 );
+
+		CERROR_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	libcerror_error_free(
+	  &error );
+
 	/* Test libcerror_system_set_error with memory_reallocate before system_string_vsnprintf failing
 	 */
 	cerror_test_realloc_attempts_before_fail = 2;
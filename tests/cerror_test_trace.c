@@ -0,0 +1,271 @@
+/*
+ * Library error trace functions test program
+ *
+ * Copyright (C) 2008-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "cerror_test_libcerror.h"
+#include "cerror_test_macros.h"
+#include "cerror_test_unused.h"
+
+/* The values recorded by the test trace callback
+ */
+int cerror_test_trace_number_of_calls        = 0;
+int cerror_test_trace_error_domain           = 0;
+int cerror_test_trace_error_code             = 0;
+uint32_t cerror_test_trace_system_error_code = 0;
+int cerror_test_trace_depth                  = 0;
+int cerror_test_trace_print_count            = 0;
+char cerror_test_trace_message[ 128 ];
+
+/* Test trace callback that records the values it is invoked with
+ */
+void cerror_test_trace_callback(
+      libcerror_error_t *error,
+      int error_domain,
+      int error_code,
+      uint32_t system_error_code,
+      int depth,
+      void *context )
+{
+	int *number_of_calls = (int *) context;
+
+	*number_of_calls += 1;
+
+	cerror_test_trace_error_domain      = error_domain;
+	cerror_test_trace_error_code        = error_code;
+	cerror_test_trace_system_error_code = system_error_code;
+	cerror_test_trace_depth             = depth;
+
+	/* The message is retrieved on demand
+	 */
+	cerror_test_trace_print_count = libcerror_error_sprint(
+	                                 error,
+	                                 cerror_test_trace_message,
+	                                 128 );
+}
+
+/* Tests the libcerror_set_trace_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int cerror_test_set_trace_callback(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libcerror_set_trace_callback(
+	          &cerror_test_trace_callback,
+	          &cerror_test_trace_number_of_calls );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 1 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_number_of_calls",
+	 cerror_test_trace_number_of_calls,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_error_domain",
+	 cerror_test_trace_error_domain,
+	 LIBCERROR_ERROR_DOMAIN_IO );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_error_code",
+	 cerror_test_trace_error_code,
+	 LIBCERROR_IO_ERROR_READ_FAILED );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_depth",
+	 cerror_test_trace_depth,
+	 1 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_print_count",
+	 cerror_test_trace_print_count,
+	 14 );
+
+	result = narrow_string_compare(
+	          cerror_test_trace_message,
+	          "Test error 1.",
+	          13 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	libcerror_error_set_static(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+	 "Test error 2." );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_number_of_calls",
+	 cerror_test_trace_number_of_calls,
+	 2 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_error_domain",
+	 cerror_test_trace_error_domain,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_depth",
+	 cerror_test_trace_depth,
+	 2 );
+
+	libcerror_system_set_error(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_OPEN_FAILED,
+	 2,
+	 "Test error %d.",
+	 3 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_number_of_calls",
+	 cerror_test_trace_number_of_calls,
+	 3 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_error_code",
+	 cerror_test_trace_error_code,
+	 LIBCERROR_IO_ERROR_OPEN_FAILED );
+
+	CERROR_TEST_ASSERT_EQUAL_UINT32(
+	 "cerror_test_trace_system_error_code",
+	 cerror_test_trace_system_error_code,
+	 2 );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_depth",
+	 cerror_test_trace_depth,
+	 3 );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test removing the callback
+	 */
+	result = libcerror_set_trace_callback(
+	          NULL,
+	          NULL );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_set(
+	 &error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_READ_FAILED,
+	 "Test error %d.",
+	 4 );
+
+	CERROR_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "cerror_test_trace_number_of_calls",
+	 cerror_test_trace_number_of_calls,
+	 3 );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libcerror_set_trace_callback(
+	          NULL,
+	          &cerror_test_trace_number_of_calls );
+
+	CERROR_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	libcerror_set_trace_callback(
+	 NULL,
+	 NULL );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc CERROR_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] CERROR_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	CERROR_TEST_UNREFERENCED_PARAMETER( argc )
+	CERROR_TEST_UNREFERENCED_PARAMETER( argv )
+
+	CERROR_TEST_RUN(
+	 "libcerror_set_trace_callback",
+	 cerror_test_set_trace_callback );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -1,6 +1,6 @@
 # Tests library functions and types.
 
-$LibraryTests = "error support system"
+$LibraryTests = "callsite error format json lifetime pool registry statistics support system trace"
 $LibraryTestsWithInput = ""
 $OptionSets = "" -split " "
 